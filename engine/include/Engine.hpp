@@ -4,9 +4,14 @@
 #include "board/Board.hpp"
 #include "board/BoardUtil.hpp"
 #include "board/Move.hpp"
+#include "moveGeneration/Perft.hpp"
+#include "util/ThreadPool.hpp"
+#include <algorithm>
 #include <future>
 #include <queue>
 #include <string>
+#include <thread>
+#include <vector>
 
 typedef bool UserColour;
 
@@ -27,12 +32,19 @@ private:
     Board* board = new Board();
     Bot* bot;
 
+    ThreadPool threadPool{std::max((int)std::thread::hardware_concurrency(), 1)};   //shared by search and perft
+
     WhiteTurn isBotWhite = false;
     GameState gameState = GameState::Live;
 
     std::queue<Move> previousMoves;
 
     std::future<Move> bestMove;
+
+    int perftThreads = std::max((int)std::thread::hardware_concurrency(), 1);
+    int perftSplitDepth = Perft::DEFAULT_SPLIT_DEPTH;
+    bool perftBulkCounting = false;
+    int perftHashSizeMb = 0;                        //0 disables the perft hash table
     
 public:
     //constructors/destructor
@@ -44,6 +56,10 @@ private:
     void parseCommand(std::string command);
     void parseGoCommand(std::string command);
     void parsePositionCommand(std::string command);
+    void parseSetOptionCommand(std::string command);
+    void parsePerftCommand(std::string command);
+    void stopSearch();
+    void reserveThreads(int threadCount);
 
     //play match methods
     void playMatch();
@@ -54,6 +70,6 @@ private:
     
     //perft methods
     void runPerftTests(int rigor);
-    uint64_t perft(int depth);
+    bool runPerftSuite(const std::vector<Perft::SuitePosition>& suite, int maxDepth);
     uint64_t perftDivide(int depth);
 };
\ No newline at end of file
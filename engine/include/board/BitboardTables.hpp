@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Contains per square lookup tables of rays and non sliding attack sets, used in place of calculating them on every call
+ *
+ * The tables are generated at compile time, squares are indexed the same as SquareIndex (8*file + rank)
+*/
+namespace BitboardTables {
+    enum Direction {
+        NORTH,
+        EAST,
+        SOUTH,
+        WEST,
+        NORTH_EAST,
+        NORTH_WEST,
+        SOUTH_EAST,
+        SOUTH_WEST
+    };
+
+    //the file and rank step of each Direction, and the Direction pointing the other way
+    constexpr int fileSteps[8]      = {0, 1,  0, -1, 1, -1,  1, -1};
+    constexpr int rankSteps[8]      = {1, 0, -1,  0, 1,  1, -1, -1};
+    constexpr int oppositeDir[8]    = {SOUTH, WEST, NORTH, EAST, SOUTH_WEST, SOUTH_EAST, NORTH_WEST, NORTH_EAST};
+
+    struct Tables {
+        uint64_t rays[8][64]{};         //indexed by Direction then square, not including the square
+        uint64_t knight[64]{};
+        uint64_t king[64]{};
+        uint64_t pawnAttacks[2][64]{};  //indexed by PieceType::WHITE/BLACK then square
+        uint64_t between[64][64]{};     //squares strictly between two aligned squares, 0 if they aren't aligned
+        uint64_t line[64][64]{};        //the full rank, file or diagonal through two aligned squares, 0 if they aren't aligned
+    };
+
+    //returns the bit of the square offset from the given square, 0 if it is off the board
+    constexpr uint64_t offsetBit(int square, int fileStep, int rankStep) {
+        int file = square / 8 + fileStep;
+        int rank = square % 8 + rankStep;
+        return (file >= 0 && file < 8 && rank >= 0 && rank < 8) ? 1ULL << (8*file + rank) : 0ULL;
+    }
+
+    constexpr Tables generateTables() {
+        Tables tables;
+        constexpr int knightSteps[8][2] = {{1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}};
+
+        for (int square = 0; square < 64; square++) {
+            for (int dir = 0; dir < 8; dir++) {
+                for (int i = 1; offsetBit(square, i*fileSteps[dir], i*rankSteps[dir]); i++)
+                    tables.rays[dir][square] |= offsetBit(square, i*fileSteps[dir], i*rankSteps[dir]);
+
+                tables.king[square] |= offsetBit(square, fileSteps[dir], rankSteps[dir]);
+                tables.knight[square] |= offsetBit(square, knightSteps[dir][0], knightSteps[dir][1]);
+            }
+
+            tables.pawnAttacks[0][square] = offsetBit(square, 1, 1)  | offsetBit(square, -1, 1);
+            tables.pawnAttacks[1][square] = offsetBit(square, 1, -1) | offsetBit(square, -1, -1);
+        }
+
+        //every pair of aligned squares lies on exactly one ray of each other
+        for (int a = 0; a < 64; a++) {
+            for (int dir = 0; dir < 8; dir++) {
+                const uint64_t line = tables.rays[dir][a] | tables.rays[oppositeDir[dir]][a] | (1ULL << a);
+
+                for (int i = 1; offsetBit(a, i*fileSteps[dir], i*rankSteps[dir]); i++) {
+                    int b = a + i * (8*fileSteps[dir] + rankSteps[dir]);
+
+                    tables.between[a][b] = tables.rays[dir][a] & ~tables.rays[dir][b] & ~(1ULL << b);
+                    tables.line[a][b] = line;
+                }
+            }
+        }
+
+        return tables;
+    }
+
+    inline constexpr Tables tables = generateTables();
+}
@@ -3,10 +3,21 @@
 #include <cstdint>
 #include <string>
 #include <array>
+#include <vector>
 
 #include "BoardUtil.hpp"
 #include "Move.hpp"
 
+/**
+ * The parts of the board state that can't be recovered from a move, saved before each move so that it can be unmade
+ */
+struct StateInfo {
+    uint64_t hash;
+    uint8_t castlingRights;
+    SquareIndex enPassantSquare;
+    PieceType::Enum killPieceType;  //the captured piece, INVALID if the move wasn't a capture
+};
+
 /**
  * Class representing the board and its relevent data, with varius functions for managing the board
  * 
@@ -19,15 +30,15 @@ private:
     std::array<uint64_t, 14> bitBoards{};
     std::array<int, 64> mailBoxBoard{};
 
-    std::array<__uint128_t, 16> enPassantData{};    //1 in the right most bit means yes
-                                                    //every time a move is played it is shifted left
-                                                    //then shifted right when unplayed
-    std::array<__uint128_t, 4> castleData{};        //1 in any bit means no
-                                                    //every time a castle or rook move is played it is shifted left
-                                                    //then shifted right when unplayed
+    uint8_t castlingRights = 0;                     //1 in the CastlePieces bit means that rook can still castle
+    SquareIndex enPassantSquare = NO_SQUARE;        //the square behind a pawn that has just moved two squares
+    std::vector<StateInfo> stateHistory;            //pushed by makeMove() and popped by unMakeMove()
+
     WhiteTurn whiteTurn = true;
     int drawMoveCounter = 0;
 
+    uint64_t hash = 0;                              //zobrist hash, updated incrementally by makeMove() and unMakeMove()
+
 public:
     //constructors/destructor
     Board();
@@ -36,16 +47,18 @@ public:
     //getters/setters
     const std::array<uint64_t, 14>& getBitBoards() const;
     const std::array<int, 64>& getMailboxBoard() const;
-    const std::array<__uint128_t, 4>& getCastleData() const;
-    const std::array<__uint128_t, 16>& getEnPassantData() const;
+    uint8_t getCastlingRights() const;
+    SquareIndex getEnPassantSquare() const;
     PieceType::Enum getType(SquareIndex index) const;
     WhiteTurn getWhiteTurn() const;
+    uint64_t getHash() const;
+    PieceType::Enum getLastCaptured() const;
     
     //public methods
     void makeMove(const Move& move);
     void unMakeMove(const Move& move);
-
-    void cleanup();
+    void makeNullMove();
+    void unMakeNullMove();
 
     void setDefaultBoard();
     void resetBoard();
@@ -53,9 +66,11 @@ public:
     void parseFen(const std::string& FEN);
     std::string toFen();
 
+    uint64_t generateHash() const;
+
 private:
     //private methods
-    void updateSpecialMoveStatus(const Move& move);
+    void updateSpecialMoveStatus(const Move& move, PieceType::Enum pieceType);
 
     void addPiece(PieceType::Enum type, SquareIndex index);
     void removePiece(PieceType::Enum type, SquareIndex index);
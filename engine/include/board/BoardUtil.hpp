@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <string>
 
+#include "BitboardTables.hpp"
+
 /**
  * Contains utility typedefs, enums, and functions used to help in various operations on the board such as move generation
 */
@@ -17,7 +19,9 @@ enum SquareIndex {
     e1, e2, e3, e4, e5, e6, e7, e8,
     f1, f2, f3, f4, f5, f6, f7, f8,
     g1, g2, g3, g4, g5, g6, g7, g8,
-    h1, h2, h3, h4, h5, h6, h7, h8
+    h1, h2, h3, h4, h5, h6, h7, h8,
+
+    NO_SQUARE
 };
 
 namespace PieceType {
@@ -51,15 +55,14 @@ namespace PieceType {
     };
 }
 
-enum EnPassantPieces {
-    A_WHITE, B_WHITE, C_WHITE, D_WHITE, E_WHITE, F_WHITE, G_WHITE, H_WHITE,
-    A_BLACK, B_BLACK, C_BLACK, D_BLACK, E_BLACK, F_BLACK, G_BLACK, H_BLACK
-};
-
 enum CastlePieces{
     W_KING, W_QUEEN, B_KING, B_QUEEN
 };
 
+//castling rights are stored as one bit per rook, indexed by CastlePieces
+#define CASTLE_RIGHT(rook) (1 << (rook))
+#define ALL_CASTLE_RIGHTS 0b1111
+
 // * ------------------------------------ [ ORTHOGANOL SHIFTERS INT ] ------------------------------------ * //
 
 //these functions move one piece one unit in the given bitboard in a certain direction
@@ -89,12 +92,12 @@ uint64_t southWestOne(uint64_t board);
 // * ------------------------------------ [ DIRECTION RAY FUNCTIONS ] ------------------------------------ * //
 
 //these functions return a mask for each square in a certain direction from the given square, not including the given square
-uint64_t calcNorthMask(SquareIndex square);
-uint64_t calcEastMask(SquareIndex square);
-uint64_t calcSouthMask(SquareIndex square);
-uint64_t calcWestMask(SquareIndex square);
-
-uint64_t calcNorthEastMask(SquareIndex square);
-uint64_t calcNorthWestMask(SquareIndex square);
-uint64_t calcSouthEastMask(SquareIndex square);
-uint64_t calcSouthWestMask(SquareIndex square);
+inline uint64_t calcNorthMask(SquareIndex square)       { return BitboardTables::tables.rays[BitboardTables::NORTH][square]; }
+inline uint64_t calcEastMask(SquareIndex square)        { return BitboardTables::tables.rays[BitboardTables::EAST][square]; }
+inline uint64_t calcSouthMask(SquareIndex square)       { return BitboardTables::tables.rays[BitboardTables::SOUTH][square]; }
+inline uint64_t calcWestMask(SquareIndex square)        { return BitboardTables::tables.rays[BitboardTables::WEST][square]; }
+
+inline uint64_t calcNorthEastMask(SquareIndex square)   { return BitboardTables::tables.rays[BitboardTables::NORTH_EAST][square]; }
+inline uint64_t calcNorthWestMask(SquareIndex square)   { return BitboardTables::tables.rays[BitboardTables::NORTH_WEST][square]; }
+inline uint64_t calcSouthEastMask(SquareIndex square)   { return BitboardTables::tables.rays[BitboardTables::SOUTH_EAST][square]; }
+inline uint64_t calcSouthWestMask(SquareIndex square)   { return BitboardTables::tables.rays[BitboardTables::SOUTH_WEST][square]; }
@@ -1,104 +1,61 @@
 #pragma once
 
+#include <cstdint>
+#include <string>
+
 #include "BoardUtil.hpp"
 
 /**
- * Contains the structs, enums and functions used to store and manipulate any possible chess move
- * 
- * Must keep the order for startPos, endPos and pieceType the same for NormalMove, PromotionMove, and CastleMove
- * for the generic updateSpecialMoveStatus() method in Board.cpp
+ * Contains the struct and enums used to store any possible chess move in 16 bits
+ *
+ * A move only stores what can't be recovered from the board it is played on, the moving and captured pieces
+ * are read from the mailbox by Board::makeMove() and the captured piece is saved for Board::unMakeMove()
  *
- * If you change their order in any way, use the MoveType specific methods in commit: b316dec916c7e2c140d3900867e1b1c7139a67c1
+ * Layout:  bits 0-5 start square, bits 6-11 end square, bits 12-13 MoveType, bits 14-15 PromotionPiece
 */
 
 enum MoveType {
     NORMAL,
     PROMOTION,
     EN_PASSANT,
-    CASTLE
-};
-
-struct NormalMove {
-    SquareIndex         startPos;
-    SquareIndex         endPos;
-    PieceType::Enum     pieceType;
-    PieceType::Enum     killPieceType;
+    CASTLE      //stored as the king move, the rook move is implied by the end square
 };
 
-struct PromotionMove {
-    SquareIndex         startPos;
-    SquareIndex         endPos;
-    PieceType::Enum     oldPieceType;
-    PieceType::Enum     newPieceType;
-    PieceType::Enum     killPieceType;
-};
-
-struct EnPassantMove {
-    SquareIndex         startPos;
-    SquareIndex         endPos;
-    PieceType::Enum     pieceType;
-    SquareIndex         killSquare;
-    PieceType::Enum     killPieceType;
-};
-
-struct CastleMove {
-    SquareIndex         primaryStartPos;
-    SquareIndex         primaryEndPos;
-    PieceType::Enum     primaryPieceType;   //white king or black king
-    SquareIndex         secondaryStartPos;
-    SquareIndex         secondaryEndPos;
-    PieceType::Enum     secondaryPieceType; //white rook or black rook
+enum PromotionPiece {
+    KNIGHT,
+    BISHOP,
+    ROOK,
+    QUEEN
 };
 
 struct Move {
-    MoveType flag;
-    int heuristic; //used for basic move ordering
-    union {
-        NormalMove      normalMove;
-        PromotionMove   promotionMove;
-        EnPassantMove   enPassantMove;
-        CastleMove      castleMove;
-    };
+    uint16_t data;
 
-    //default constructor
-    Move() : flag(NORMAL) {}
+    //default constructor, the null move
+    Move() : data(0) {}
 
-    //constructors for each move type
-    Move(MoveType flag, NormalMove move) :
-        flag(flag),
-        normalMove(move),
-        heuristic(move.killPieceType == PieceType::INVALID ? 1 : 4)
-    {}
+    //constructors
+    explicit Move(uint16_t packed) : data(packed) {}
 
-    Move(MoveType flag, PromotionMove move) :
-        flag(flag),
-        promotionMove(move),
-        heuristic(move.killPieceType == PieceType::INVALID ? 3 : 6)
+    Move(SquareIndex startPos, SquareIndex endPos, MoveType flag = NORMAL, PromotionPiece promotion = KNIGHT) :
+        data(startPos | (endPos << 6) | (flag << 12) | (promotion << 14))
     {}
 
-    Move(MoveType flag, EnPassantMove move) :
-        flag(flag),
-        enPassantMove(move),
-        heuristic(5)
-    {}
+    //decode helpers
+    SquareIndex     getStartPos() const         { return (SquareIndex)(data & 0x3F); }
+    SquareIndex     getEndPos() const           { return (SquareIndex)((data >> 6) & 0x3F); }
+    MoveType        getFlag() const             { return (MoveType)((data >> 12) & 0x3); }
+    PromotionPiece  getPromotionPiece() const   { return (PromotionPiece)(data >> 14); }
 
-    Move(MoveType flag, CastleMove move) :
-        flag(flag),
-        castleMove(move),
-        heuristic(2)
-    {}
+    //the promoted piece for the given colour, only valid for promotion moves
+    PieceType::Enum getPromotionPieceType(int colour) const {
+        return (PieceType::Enum)(PieceType::WHITE_KNIGHT + 2 * getPromotionPiece() + colour);
+    }
 
     void print() const;
     std::string toString() const;
+    uint16_t pack() const { return data; }
 
-    bool operator==(const Move& other) const;
+    bool operator==(const Move& other) const { return data == other.data; }
+    bool operator!=(const Move& other) const { return data != other.data; }
 };
-
-/*
-promotion capture       6
-en passant              5
-normal capture          4
-promotion non capture   3
-castle                  2
-normal non capture      1
-*/
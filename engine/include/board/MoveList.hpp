@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cassert>
+#include <utility>
+
+#include "Move.hpp"
+
+/**
+ * Fixed capacity list of moves stored inline, used in place of std::vector<Move> so that generating
+ * and searching moves never touches the allocator
+ *
+ * Each move has an ordering score kept in a parallel array, so the moves themselves stay 2 bytes each.
+ * The storage is left uninitialised, only the first size() moves and scores are ever valid
+*/
+class MoveList {
+public:
+    static const int MAX_MOVES = 256; //the most legal moves in any position is 218
+
+private:
+    union {
+        Move moves[MAX_MOVES];
+    };
+    int scores[MAX_MOVES];
+    int count = 0;
+
+public:
+    //constructors/destructor
+    MoveList() {}
+
+    //getters/setters
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    Move& operator[](int i) { return moves[i]; }
+    const Move& operator[](int i) const { return moves[i]; }
+
+    int& getScore(int i) { return scores[i]; }
+    int getScore(int i) const { return scores[i]; }
+
+    Move* begin() { return moves; }
+    Move* end() { return moves + count; }
+    const Move* begin() const { return moves; }
+    const Move* end() const { return moves + count; }
+
+    //public methods
+    template <typename... Args>
+    void emplace_back(Args&&... args) {
+        assert(count < MAX_MOVES);
+        moves[count++] = Move(std::forward<Args>(args)...);
+    }
+    void push_back(const Move& move) {
+        assert(count < MAX_MOVES);
+        moves[count++] = move;
+    }
+
+    //drops every move after the first size moves
+    void resize(int size) {
+        assert(size <= count);
+        count = size;
+    }
+    void clear() { count = 0; }
+
+    //swaps the highest scoring move from index onwards into index, so moves can be picked best first without sorting
+    //the ones that are never reached
+    void selectBest(int index) {
+        int best = index;
+        for (int i = index + 1; i < count; i++)
+            if (scores[i] > scores[best])
+                best = i;
+
+        std::swap(moves[index], moves[best]);
+        std::swap(scores[index], scores[best]);
+    }
+
+    //stable insertion sort of the moves by descending score, move lists are short enough that this beats std::sort
+    void sortByScore() {
+        for (int i = 1; i < count; i++) {
+            Move move = moves[i];
+            int score = scores[i];
+
+            int j = i - 1;
+            for (; j >= 0 && scores[j] < score; j--) {
+                moves[j+1] = moves[j];
+                scores[j+1] = scores[j];
+            }
+            moves[j+1] = move;
+            scores[j+1] = score;
+        }
+    }
+};
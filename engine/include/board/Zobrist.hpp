@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+/**
+ * Contains the random keys used to build and incrementally update the zobrist hash of a board
+ *
+ * The keys are generated at compile time using a fixed seed so that hashes are identical between runs
+*/
+namespace Zobrist {
+    //splitmix64, used only to fill the key tables below
+    constexpr uint64_t nextKey(uint64_t& state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    struct Keys {
+        uint64_t pieces[12][64]{};  //indexed by PieceType::Enum then SquareIndex
+        uint64_t castling[16]{};    //indexed by castling rights
+        uint64_t enPassant[8]{};    //indexed by file
+        uint64_t blackTurn{};
+    };
+
+    constexpr Keys generateKeys() {
+        Keys keys;
+        uint64_t state = 0x2545F4914F6CDD1DULL;
+
+        for (auto& piece : keys.pieces)
+            for (auto& square : piece)
+                square = nextKey(state);
+        for (auto& castle : keys.castling)
+            castle = nextKey(state);
+        for (auto& file : keys.enPassant)
+            file = nextKey(state);
+        keys.blackTurn = nextKey(state);
+
+        return keys;
+    }
+
+    inline constexpr Keys keys = generateKeys();
+}
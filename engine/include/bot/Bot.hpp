@@ -2,11 +2,16 @@
 
 #include "board/Board.hpp"
 #include "board/Move.hpp"
+#include "board/MoveList.hpp"
 #include "bot/PrincipalVariation.hpp"
+#include "bot/TranspositionTable.hpp"
+#include "util/ThreadPool.hpp"
 
 #include <chrono>
-#include <semaphore>
 #include <atomic>
+#include <cstdint>
+#include <deque>
+#include <vector>
 
 /**
  * Class representing the Bot and its relevent data/ references.
@@ -15,24 +20,107 @@
  * and return the predicted best move
  */
 class Bot {
+public:
+    static constexpr int MAX_THREADS = 256;
+    static constexpr int ASPIRATION_WINDOW = 25;        //half width of the first window in centipawns
+    static constexpr int ASPIRATION_MAX_WINDOW = 1000;  //half width past which the window is opened fully
+    static constexpr int NULL_MOVE_MIN_DEPTH = 3;
+    static constexpr int MAX_PLY = pVariation::MAX_LENGTH;
+    static constexpr int HISTORY_MAX = 16384;           //history scores are kept within +-HISTORY_MAX by the gravity update
+
+    static constexpr int LMR_MIN_DEPTH = 3;
+    static constexpr int LMR_MIN_MOVE_INDEX = 3;        //the hash move and first ordered moves are never reduced
+    static constexpr int LMR_TABLE_DEPTH = 64;
+    static constexpr int DEFAULT_LMR_BASE = 75;         //hundredths of a ply
+    static constexpr int DEFAULT_LMR_DIVISOR = 225;     //hundredths
+
+    static constexpr int LMP_MAX_DEPTH = 3;
+    static constexpr int DEFAULT_LMP_BASE = 3;          //quiet moves searched before pruning is lmpBase + depth^2
+
+    static constexpr int RFP_MAX_DEPTH = 6;
+    static constexpr int DEFAULT_RFP_MARGIN = 80;       //centipawns per ply of depth
+    static constexpr int FUTILITY_MAX_DEPTH = 3;
+    static constexpr int DEFAULT_FUTILITY_MARGIN = 120; //centipawns per ply of depth
+    static constexpr int RAZOR_MAX_DEPTH = 2;
+    static constexpr int DEFAULT_RAZOR_MARGIN = 250;    //centipawns per ply of depth
+
+    static constexpr int DELTA_MARGIN = 200;            //centipawns a capture may gain beyond the value of its victim
+
+    static constexpr int ONE_PLY = 4;                   //extensions are in fractions of a ply, carried down the line until they add up
+    static constexpr int CHECK_EXTENSION = 4;
+    static constexpr int RECAPTURE_EXTENSION = 2;
+    static constexpr int PAWN_SEVENTH_EXTENSION = 2;    //a pawn moving to the rank before promotion
+
 private:
+    /**
+     * Search state private to one thread of the Lazy SMP search, every thread searches its own copy of the board
+     * and only shares results with the others through the transposition table
+     */
+    struct SearchThread {
+        int         id;                 //0 is the main thread
+        Board       board;
+        pVariation  pv;                 //pv of the last completed iteration
+        PvTable     pvTable;            //lines of the iteration in progress
+        int         score = 0;          //score of the last completed iteration
+        int         completedDepth = 0;
+        int         rootDepth = 0;      //depth of the current iteration, lines aren't extended past twice it
+        std::atomic<uint64_t> nodes = 0;  //only written by this thread, read by the main thread to report the total
+        uint64_t    qNodes = 0;         //the part of nodes searched by quiescence
+        int         selDepth = 0;       //deepest ply reached by the current iteration
+        int         maxQDepth = 0;      //deepest ply into quiescence reached by the current iteration
+        int         timerPoll = 0;      //nodes of either search since the main thread last checked the clock
+
+        //move ordering heuristics, learnt from the beta cutoffs of quiet moves
+        Move        moveStack[MAX_PLY];     //the move made at each ply, a null Move for a null move
+        Move        killers[MAX_PLY][2];    //the last two quiet moves to cause a cutoff at each ply
+        Move        counterMoves[12][64];   //the quiet move that last refuted a move, indexed by its piece then end square
+        int         history[2][64][64]{};   //indexed by colour, start square then end square
+
+        int         extensionCarry[MAX_PLY+1]{};    //fractional extension carried down the line into each ply
+
+        SearchThread(int id, const Board& board) : id(id), board(board) {}
+
+        //only this thread writes nodes, so it doesn't need an atomic increment to be read by the others
+        void countNode() { nodes.store(nodes.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+    };
+
     static bool isPestoInitialised;
     static const std::string OPENING_BOOKS[];
-    
-    static const int NUM_THREADS;
-    static std::counting_semaphore<> threadsAvailable;
 
     Board& board;
+    ThreadPool& threadPool;
     pVariation principalVariation; //could this just be a vector?
+    TranspositionTable transpositionTable;
+    std::deque<SearchThread> searchThreads;    //threads of the current search, a deque as they can't be moved
 
     const int SEARCH_TIMER_NODE_FREQUENCY;
     std::chrono::milliseconds thinkTime;
 
+    std::chrono::high_resolution_clock::time_point searchStart;
     std::chrono::high_resolution_clock::time_point searchDeadline;
-    int nodesSearched = 0;
-    bool searchDeadlineReached = false;
+    uint64_t nodesSearched = 0;
 
-    std::atomic<bool> forcedStop;
+    int threadCount;
+    std::atomic<bool> searchStopped;    //set by the deadline, the stop command, or the main thread finishing
+
+    bool usePvs = true;
+    bool useAspirationWindows = true;
+    bool useNullMovePruning = true;
+    bool useNullMoveVerification = false;
+    bool useLmr = true;
+    bool useLmp = true;
+    bool useReverseFutilityPruning = true;
+    bool useFutilityPruning = true;
+    bool useRazoring = true;
+    bool useDeltaPruning = true;
+
+    int lmrBase;
+    int lmrDivisor;
+    int lmpBase = DEFAULT_LMP_BASE;
+    int rfpMargin = DEFAULT_RFP_MARGIN;
+    int futilityMargin = DEFAULT_FUTILITY_MARGIN;
+    int razorMargin = DEFAULT_RAZOR_MARGIN;
+    int lmrReductions[LMR_TABLE_DEPTH][MoveList::MAX_MOVES];    //indexed by depth then move index, in plies
 
     int timeLeftMs = 600000;
     int timeIncrement = 0;
@@ -42,12 +130,31 @@ private:
 
 public:
     //constructors/destructor
-    Bot(Board& board);
+    Bot(Board& board, ThreadPool& threadPool);
     ~Bot();
 
     //getters/setters
     void setTimeLeftMs(int time);
     void setTimeIncrementMs(int time);
+    void setHashSizeMb(int sizeMb);
+    void setThreadCount(int count);
+    void setUsePvs(bool enabled);
+    void setUseAspirationWindows(bool enabled);
+    void setUseNullMovePruning(bool enabled);
+    void setUseNullMoveVerification(bool enabled);
+    void setUseLmr(bool enabled);
+    void setUseLmp(bool enabled);
+    void setUseReverseFutilityPruning(bool enabled);
+    void setUseFutilityPruning(bool enabled);
+    void setUseRazoring(bool enabled);
+    void setUseDeltaPruning(bool enabled);
+    void setLmrCoefficients(int base, int divisor);
+    void setLmpBase(int base);
+    void setRfpMargin(int margin);
+    void setFutilityMargin(int margin);
+    void setRazorMargin(int margin);
+    int getLmrBase() const { return lmrBase; }
+    int getLmrDivisor() const { return lmrDivisor; }
 
     //public methods
     Move getBestMove();
@@ -58,16 +165,15 @@ public:
 private:
     //private methods
     Move calcBestMove();
-    int negaMax(int depth, int alpha, int beta, pVariation& parentLine);
-    int quiescence(int alpha, int beta);
+    void iterativeDeepening(SearchThread& thread);
+    int aspirationSearch(SearchThread& thread, int depth);
+    int negaMax(SearchThread& thread, int depth, int ply, int alpha, int beta, bool allowNullMove = true);
+    int quiescence(SearchThread& thread, int ply, int qDepth, int alpha, int beta);
     bool queryOpeningBook(std::string bookName, Move& move);
 
-    //concurrency methods
-    int negaMaxConcurrent(int depth, int alpha, int beta, pVariation& parentLine, Board b);
-    int quiescence(int alpha, int beta, Board& b);
-
     //helper methods
-    void orderMoves(std::vector<Move>& moves);
-    void orderMovesQuiescence(std::vector<Move>& moves);
+    void updateQuietHeuristics(SearchThread& thread, int ply, int depth, const Move& bestMove, const Move* quietsTried, int quietCount);
     bool checkTimer();
+    bool pollTimer(SearchThread& thread);
+    void printInfo(const SearchThread& thread);
 };
@@ -7,9 +7,11 @@
  */
 
 namespace Eval {
-    extern const int CHEKMATE_ABSOLUTE_SCORE;
+    extern const int CHEKMATE_ABSOLUTE_SCORE;   //being mated scores -(CHEKMATE_ABSOLUTE_SCORE - ply), so nearer mates score higher
+    extern const int MATE_BOUND;                //any score past +-MATE_BOUND is a mate
     
     void initPestoTables();
     int pestoEval(const Board& boardRef);
-    int terminalNodeEval(const Board& boardRef);
+    int terminalNodeEval(const Board& boardRef, int ply);
+    bool isMateScore(int score);
 }
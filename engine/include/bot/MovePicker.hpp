@@ -0,0 +1,68 @@
+#pragma once
+
+#include "board/Board.hpp"
+#include "board/Move.hpp"
+#include "board/MoveList.hpp"
+
+/**
+ * Staged move picker, hands out the legal moves of a node one at a time in the order they should be searched
+ *
+ * Moves are generated a stage at a time and only once the stage before runs out, so a node that cuts off on the
+ * hash move or a good capture never generates or scores its quiet moves. Within a stage the best remaining move
+ * is selected each time instead of sorting the whole stage up front
+ */
+class MovePicker {
+public:
+    enum Stage {
+        HASH_MOVE,
+        GENERATE_CAPTURES,
+        GOOD_CAPTURES,      //captures and queen promotions that don't lose material by static exchange, by mvv-lva
+        REFUTATIONS,        //the two killers then the countermove
+        GENERATE_QUIETS,
+        QUIETS,             //by history
+        BAD_CAPTURES,       //in the order they were deferred, which is by mvv-lva
+        QUIET_CHECKS,       //quiescence only, the quiet moves that give check
+        GENERATE_EVASIONS,
+        EVASIONS,           //captures by mvv-lva then quiet moves by history
+        DONE
+    };
+
+private:
+    const Board& board;
+    const int (&history)[64][64];   //history of the side to move, indexed by start square then end square
+
+    Stage stage;
+    bool inCheck;
+    bool skipBadCaptures;           //quiescence only searches the captures that don't lose material
+    bool includeQuietChecks;
+
+    Move hashMove;
+    Move refutations[3];
+    int refutationIndex = 0;
+
+    MoveList moves;                 //the moves of the current stage
+    MoveList badCaptures;
+    int index = 0;
+
+public:
+    //constructors/destructor
+    MovePicker(const Board& board, uint16_t hashMove, const Move (&killers)[2], const Move& counterMove, const int (&history)[64][64], bool inCheck);
+    MovePicker(const Board& board, const int (&history)[64][64], bool inCheck, bool includeQuietChecks = false);
+
+    //getters/setters
+    Stage getStage() const { return stage; }
+
+    //public methods
+    Move next();
+
+    static int mvvLva(const Board& board, const Move& move);
+    static bool isTactical(const Board& board, const Move& move);
+
+private:
+    //helper methods
+    void scoreCaptures();
+    void scoreQuiets();
+    void scoreEvasions();
+    void keepChecks();
+    bool isRefutation(const Move& move) const;
+};
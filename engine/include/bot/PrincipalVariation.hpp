@@ -3,8 +3,37 @@
 #include "board/Move.hpp"
 
 typedef struct pVariation {
+    static const int MAX_LENGTH = 128;  //also the deepest ply the search can reach
+
     int moveCount{};
-    Move moves[15];
+    Move moves[MAX_LENGTH];
 
     void print() const;
-} pVariation;
\ No newline at end of file
+} pVariation;
+
+/**
+ * Triangular table of the best lines found by the search, one row per ply
+ *
+ * Row ply holds the line from the node at that ply in columns ply onwards, so a node that raises alpha only has to
+ * write its move and append the row below it. Every node clears its row on entry, so a node that returns without
+ * searching any moves leaves an empty line
+ */
+class PvTable {
+private:
+    Move moves[pVariation::MAX_LENGTH][pVariation::MAX_LENGTH];
+    int ends[pVariation::MAX_LENGTH + 1];   //one past the last move of each row
+
+public:
+    //public methods
+    void clear(int ply) { ends[ply] = ply; }
+
+    //makes the line at ply the given move followed by the line at ply+1
+    void update(int ply, const Move& move) {
+        moves[ply][ply] = move;
+        for (int i = ply + 1; i < ends[ply + 1]; i++)
+            moves[ply][i] = moves[ply + 1][i];
+        ends[ply] = ends[ply + 1];
+    }
+
+    void copyRoot(pVariation& line) const;
+};
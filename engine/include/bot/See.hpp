@@ -0,0 +1,15 @@
+#pragma once
+
+#include "board/Board.hpp"
+#include "board/Move.hpp"
+
+/**
+ * Defines a static exchange evaluation, the material won or lost by a capture once every piece attacking the
+ * target square, including those behind other attackers, has recaptured in order of least valuable first
+ */
+
+namespace SEE {
+    extern const int PIECE_VALUES[6];
+
+    int evaluate(const Board& board, const Move& move);
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * The type of score stored in a transposition table entry
+ */
+enum Bound {
+    EXACT,
+    LOWER,  //the score is at least this value, i.e. it failed high
+    UPPER   //the score is at most this value, i.e. it failed low
+};
+
+/**
+ * A decoded transposition table entry
+ */
+struct TTEntry {
+    int         score;
+    int         depth;
+    Bound       bound;
+    uint16_t    move;   //packed move, see Move::pack(), 0 if there is no best move
+};
+
+/**
+ * Fixed size, bucketed hash table storing the results of previous searches, keyed by zobrist hash
+ *
+ * Every slot stores the key xored with the data, so that a slot torn by two threads writing to it at
+ * once fails the key check on probe instead of returning a corrupted entry. This lets search threads
+ * share the table without any locking
+ */
+class TranspositionTable {
+public:
+    static constexpr int DEFAULT_SIZE_MB = 16;
+    static constexpr int MAX_SIZE_MB = 4096;
+
+private:
+    static constexpr int BUCKET_SIZE = 4;
+
+    struct Slot {
+        std::atomic<uint64_t> key{};    //zobrist hash ^ data
+        std::atomic<uint64_t> data{};   //move | score | depth | bound | age
+    };
+
+    struct alignas(64) Bucket {
+        Slot slots[BUCKET_SIZE];
+    };
+
+    Bucket* buckets = nullptr;
+    size_t bucketCount = 0;
+    uint8_t age = 0;
+
+public:
+    //constructors/destructor
+    TranspositionTable(size_t sizeMb);
+    ~TranspositionTable();
+
+    //public methods
+    void resize(size_t sizeMb);
+    void clear();
+    void newSearch();
+
+    bool probe(uint64_t hash, TTEntry& entry) const;
+    void store(uint64_t hash, int depth, int score, Bound bound, uint16_t move);
+
+private:
+    //helper methods
+    Bucket& getBucket(uint64_t hash) const;
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+
+#include "board/BoardUtil.hpp"
+
+/**
+ * Contains precomputed rook and bishop attack tables, indexed by the occupied squares on each of the sliders rays
+ *
+ * The index is found with a fancy magic multiply-shift, or with the bmi2 pext instruction when the cpu supports it.
+ * initSliderAttacks() must be called once before any lookups are made
+*/
+
+struct SliderMagic {
+    uint64_t    mask;       //relevant occupancy, the sliders rays excluding the board edges
+    uint64_t    magic;
+    uint64_t*   attacks;    //this squares slice of the attack table
+    unsigned    shift;
+};
+
+extern SliderMagic rookMagics[64];
+extern SliderMagic bishopMagics[64];
+extern bool usePext;
+
+void initSliderAttacks();
+
+//extracts the bits of source selected by mask into the low bits of the result, only valid if usePext is set
+inline uint64_t parallelBitsExtract(uint64_t source, uint64_t mask) {
+#if defined(__BMI2__)
+    return __builtin_ia32_pext_di(source, mask);
+#elif defined(__x86_64__)
+    uint64_t result;
+    asm("pextq %2, %1, %0" : "=r"(result) : "r"(source), "rm"(mask));
+    return result;
+#else
+    return 0;
+#endif
+}
+
+inline uint64_t sliderIndex(const SliderMagic& m, uint64_t occupied) {
+    if (usePext)
+        return parallelBitsExtract(occupied, m.mask);
+    return ((occupied & m.mask) * m.magic) >> m.shift;
+}
+
+//returns all squares attacked by a rook/bishop/queen on the given square, including occupied squares
+inline uint64_t rookAttacks(SquareIndex square, uint64_t occupied) {
+    const SliderMagic& m = rookMagics[square];
+    return m.attacks[sliderIndex(m, occupied)];
+}
+inline uint64_t bishopAttacks(SquareIndex square, uint64_t occupied) {
+    const SliderMagic& m = bishopMagics[square];
+    return m.attacks[sliderIndex(m, occupied)];
+}
+inline uint64_t queenAttacks(SquareIndex square, uint64_t occupied) {
+    return rookAttacks(square, occupied) | bishopAttacks(square, occupied);
+}
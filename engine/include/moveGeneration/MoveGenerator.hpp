@@ -1,13 +1,26 @@
 #pragma once
 
-#include <vector>
-
 #include "board/Board.hpp"
+#include "board/Move.hpp"
+#include "board/MoveList.hpp"
 
 /**
  * Contains move generation functions
 */
 namespace MoveGeneration {
-    std::vector<Move> generateMoves(Board& board);
+    //the subset of the legal moves to generate
+    enum GenType {
+        ALL,
+        CAPTURES,   //captures, en passant and queen promotions
+        QUIETS,     //everything else, including under promotions and castling
+        EVASIONS    //every legal move when in check
+    };
+
+    void generateMoves(const Board& board, MoveList& moves);
+    void generateCaptures(const Board& board, MoveList& moves);
+    void generateQuiets(const Board& board, MoveList& moves);
+    void generateEvasions(const Board& board, MoveList& moves);
     bool isKingTargeted(const Board& board);
+    bool isLegal(const Board& board, const Move& move);
+    bool givesCheck(const Board& board, const Move& move);
 }
@@ -1,9 +1,9 @@
 #pragma once
 
-#include <vector>
-
 #include "board/Board.hpp"
 #include "board/BoardUtil.hpp"
+#include "board/MoveList.hpp"
+#include "moveGeneration/MoveGenerator.hpp"
 
 /**
  * Contains various functions used for generating target bitboards, and piece moves for a given board
@@ -11,22 +11,37 @@
  * Used by the move generator function to generate all possible moves for a given board
 */
 
+/**
+ * Masks restricting the target squares of each piece so that only legal moves are generated,
+ * calculated once per position by generateLegalityMasks()
+ */
+struct LegalityMasks {
+    uint64_t checkers;          //opposition pieces giving check
+    uint64_t checkMask;         //squares that capture or block the checking piece, every square if not in check
+    uint64_t orthogonalPins;    //squares from the king up to and including each rook/queen pinning a piece
+    uint64_t diagonalPins;      //squares from the king up to and including each bishop/queen pinning a piece
+    uint64_t targeted;          //squares targeted by the opposition, seeing through the king
+};
+
 // * ------------------------------------------ [ IS TARGETED ] ------------------------------------------ * //
 
 bool isTargeted(const Board& board, WhiteTurn whiteTurn, SquareIndex i);
+uint64_t generateAttackersBitboard(const Board& board, WhiteTurn whiteTurn, SquareIndex i, uint64_t occupied);
+uint64_t generateTargetedBitboard(const Board& board, WhiteTurn whiteTurn, uint64_t occupied);
+LegalityMasks generateLegalityMasks(const Board& board, WhiteTurn whiteTurn, SquareIndex kingIndex);
 
 // * ----------------------------------- [ BITBOARD MOVE SERIALISATION ] --------------------------------- * //
 
-void generateKingMoves(std::vector<Move>& moves, const Board& board, WhiteTurn whiteTurn, uint64_t king, uint64_t friendlyPieces);
-void generateKnightMoves(std::vector<Move>& moves, const Board& board, WhiteTurn whiteTurn, uint64_t knights, uint64_t friendlyPieces);
+void generateKingMoves(MoveList& moves, uint64_t king, uint64_t friendlyPieces, const LegalityMasks& masks);
+void generateKnightMoves(MoveList& moves, uint64_t knights, uint64_t friendlyPieces, const LegalityMasks& masks);
 
-void generateRookMoves(std::vector<Move>& moves, const Board& board, WhiteTurn whiteTurn, uint64_t rooks, uint64_t occupied, uint64_t friendlyPieces);
-void generateBishopMoves(std::vector<Move>& moves, const Board& board, WhiteTurn whiteTurn, uint64_t bishops, uint64_t occupied, uint64_t friendlyPieces);
-void generateQueenMoves(std::vector<Move>& moves, const Board& board, WhiteTurn whiteTurn, uint64_t queens, uint64_t occupied, uint64_t friendlyPieces);
+void generateRookMoves(MoveList& moves, uint64_t rooks, uint64_t occupied, uint64_t friendlyPieces, const LegalityMasks& masks);
+void generateBishopMoves(MoveList& moves, uint64_t bishops, uint64_t occupied, uint64_t friendlyPieces, const LegalityMasks& masks);
+void generateQueenMoves(MoveList& moves, uint64_t queens, uint64_t occupied, uint64_t friendlyPieces, const LegalityMasks& masks);
 
-void generatePawnMoves(std::vector<Move>& moves, const Board& board, WhiteTurn whiteTurn, uint64_t pawns, uint64_t unoccupied, uint64_t oppositionPieces);
-void generateCastlingMoves(std::vector<Move>& moves, const Board& board, WhiteTurn whiteTurn, uint64_t occupied, std::array<__uint128_t, 4> castleData);
-void generateEnPassantMoves(std::vector<Move>& moves, const Board& board, WhiteTurn whiteTurn, uint64_t pawns, std::array<__uint128_t, 16> enPassantData);
+void generatePawnMoves(MoveList& moves, WhiteTurn whiteTurn, uint64_t pawns, uint64_t unoccupied, uint64_t oppositionPieces, const LegalityMasks& masks, MoveGeneration::GenType genType);
+void generateCastlingMoves(MoveList& moves, WhiteTurn whiteTurn, uint64_t occupied, uint8_t castlingRights, const LegalityMasks& masks);
+void generateEnPassantMoves(MoveList& moves, const Board& board, WhiteTurn whiteTurn, uint64_t pawns, SquareIndex enPassantSquare, const LegalityMasks& masks);
 
 // * ------------------------------------ [ BITBOARD MOVE GENERATION ] ----------------------------------- * //
 
@@ -47,4 +62,4 @@ uint64_t generateQueenBitboardSingular(SquareIndex square, uint64_t occupied, ui
 uint64_t generatePawnPushBitboard(WhiteTurn whiteTurn, uint64_t pawns, uint64_t unoccupied);
 uint64_t generatePawnAttackBitboard(WhiteTurn whiteTurn, uint64_t pawns, uint64_t oppositionPieces);
 uint64_t generatePawnTargetBitboard(WhiteTurn whiteTurn, uint64_t pawns);
-uint64_t generateEnPassantBitboard(WhiteTurn whiteTurn, uint64_t pawns, std::array<__uint128_t, 16> enPassantData);
\ No newline at end of file
+uint64_t generateEnPassantBitboard(WhiteTurn whiteTurn, uint64_t pawns, SquareIndex enPassantSquare);
\ No newline at end of file
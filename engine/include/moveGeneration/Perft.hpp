@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "board/Board.hpp"
+#include "util/ThreadPool.hpp"
+
+/**
+ * Contains perft functions, counting the leaf nodes of the legal move tree to a given depth
+ *
+ * Used to check move generation against known results and to benchmark its throughput
+*/
+namespace Perft {
+    const int DEFAULT_SPLIT_DEPTH = 2;
+
+    /**
+     * Fixed size table of subtree node counts keyed by zobrist hash and depth, shared between perft threads
+     *
+     * Like the transposition table every slot stores its key xored with its data, so torn writes fail the key check
+     */
+    class HashTable {
+    private:
+        struct Slot {
+            std::atomic<uint64_t> key{};    //zobrist hash ^ data
+            std::atomic<uint64_t> data{};   //nodes | depth << 56
+        };
+
+        Slot* slots = nullptr;
+        size_t slotCount = 0;
+
+    public:
+        //constructors/destructor
+        HashTable(size_t sizeMb);
+        ~HashTable();
+
+        //public methods
+        bool probe(uint64_t hash, int depth, uint64_t& nodes) const;
+        void store(uint64_t hash, int depth, uint64_t nodes);
+    };
+
+    struct Options {
+        bool        bulkCounting = false;   //count the moves at depth 1 instead of making them
+        HashTable*  table = nullptr;        //cache of subtree counts, not used if null
+    };
+
+    struct ThreadStats {
+        uint64_t    nodes = 0;
+        uint64_t    jobs = 0;
+        double      seconds = 0;
+    };
+
+    struct Result {
+        uint64_t                    nodes = 0;
+        double                      seconds = 0;
+        std::vector<ThreadStats>    threads;
+    };
+
+    //a position of a perft suite and its known node counts
+    struct SuitePosition {
+        std::string                             fen;
+        std::vector<std::pair<int, uint64_t>>   counts;    //depth, expected nodes
+    };
+
+    uint64_t perft(Board& board, int depth);
+    uint64_t perft(Board& board, int depth, const Options& options);
+    Result parallelPerft(ThreadPool& threadPool, const Board& board, int depth, int threadCount, int splitDepth, const Options& options = {});
+
+    bool loadSuite(const std::string& path, std::vector<SuitePosition>& suite);
+}
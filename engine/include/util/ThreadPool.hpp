@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Persistent pool of worker threads, created once and reused by every search and perft instead of starting
+ * an OS thread per task
+ *
+ * Every worker has its own deque of jobs. A worker runs the newest job of its own deque first and steals the
+ * oldest job of another worker's deque when its own is empty. Jobs submitted from inside a job go to the
+ * submitting worker's deque, jobs submitted from outside the pool are spread over the workers round robin
+*/
+class ThreadPool {
+private:
+    using Job = std::function<void()>;
+
+    struct alignas(64) WorkerQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> threads;
+
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    std::atomic<int> queuedJobs = 0;        //jobs pushed but not yet taken by a worker
+    std::atomic<size_t> nextQueue = 0;
+    bool stopping = false;
+
+public:
+    //constructors/destructor
+    ThreadPool(int threadCount);
+    ~ThreadPool();
+
+    //getters/setters
+    int size() const { return threads.size(); }
+
+    //public methods
+    void resize(int threadCount);
+
+    /**
+     * Queues a callable to run on the pool
+     *
+     * @param job the callable, taking no arguments
+     * @return a future holding the result of the callable
+     */
+    template <typename F>
+    std::future<std::invoke_result_t<F>> submit(F&& job) {
+        //std::function needs a copyable callable, so the move only task is shared instead
+        auto task = std::make_shared<std::packaged_task<std::invoke_result_t<F>()>>(std::forward<F>(job));
+        std::future<std::invoke_result_t<F>> result = task->get_future();
+
+        push([task](){ (*task)(); });
+        return result;
+    }
+
+    /**
+     * Blocks until the future is ready, running queued jobs in the meantime so that a job waiting on jobs it
+     * submitted can't deadlock the pool
+     *
+     * @param future the future to wait for
+     */
+    template <typename T>
+    void waitFor(std::future<T>& future) {
+        while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            if (!runQueuedJob())
+                future.wait_for(std::chrono::microseconds(100));
+    }
+
+private:
+    //helper methods
+    void start(int threadCount);
+    void stop();
+    void push(Job job);
+    bool runQueuedJob();
+    void workerLoop(int index);
+};
@@ -1,7 +1,9 @@
 #include "Engine.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <cctype>
 #include <chrono>
 #include <cstdint>
 #include <future>
@@ -9,20 +11,25 @@
 #include <ostream>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "bot/Bot.hpp"
+#include "bot/TranspositionTable.hpp"
 #include "board/Board.hpp"
 #include "board/BoardUtil.hpp"
 #include "board/Move.hpp"
+#include "moveGeneration/MagicBitboards.hpp"
 #include "moveGeneration/MoveGenerator.hpp"
+#include "moveGeneration/Perft.hpp"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // * ------------------------------------ [ CONSTRUCTORS/DESCTUCTOR ] ------------------------------------ * //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 Engine::Engine() {    
-    bot = new Bot(*board);
+    initSliderAttacks();
+    bot = new Bot(*board, threadPool);
 
     std::string input;
     std::getline(std::cin, input);
@@ -34,6 +41,9 @@ Engine::Engine() {
 }
 
 Engine::~Engine() {
+    //the search runs on the pool, so it has to finish before the bot goes
+    stopSearch();
+
     delete board;
     delete bot;
 }
@@ -55,12 +65,34 @@ void Engine::parseCommand(std::string command) {
     else if (word == "position") {
         parsePositionCommand(command);
     }
+    else if (word == "setoption") {
+        parseSetOptionCommand(command);
+    }
     else if (word == "uci") {
         // std::cout << "id name TobyBot 1.0" << std::endl;
         // std::cout << "id name Toby Hothersall" << std::endl;
+        std::cout << "option name Hash type spin default " << TranspositionTable::DEFAULT_SIZE_MB << " min 1 max " << TranspositionTable::MAX_SIZE_MB << std::endl;
+        std::cout << "option name PVS type check default true" << std::endl;
+        std::cout << "option name AspirationWindows type check default true" << std::endl;
+        std::cout << "option name NullMovePruning type check default true" << std::endl;
+        std::cout << "option name NullMoveVerification type check default false" << std::endl;
+        std::cout << "option name LMR type check default true" << std::endl;
+        std::cout << "option name LMP type check default true" << std::endl;
+        std::cout << "option name LmrBase type spin default " << Bot::DEFAULT_LMR_BASE << " min 0 max 500" << std::endl;
+        std::cout << "option name LmrDivisor type spin default " << Bot::DEFAULT_LMR_DIVISOR << " min 50 max 1000" << std::endl;
+        std::cout << "option name LmpBase type spin default " << Bot::DEFAULT_LMP_BASE << " min 0 max 64" << std::endl;
+        std::cout << "option name ReverseFutilityPruning type check default true" << std::endl;
+        std::cout << "option name FutilityPruning type check default true" << std::endl;
+        std::cout << "option name Razoring type check default true" << std::endl;
+        std::cout << "option name DeltaPruning type check default true" << std::endl;
+        std::cout << "option name RfpMargin type spin default " << Bot::DEFAULT_RFP_MARGIN << " min 0 max 1000" << std::endl;
+        std::cout << "option name FutilityMargin type spin default " << Bot::DEFAULT_FUTILITY_MARGIN << " min 0 max 1000" << std::endl;
+        std::cout << "option name RazorMargin type spin default " << Bot::DEFAULT_RAZOR_MARGIN << " min 0 max 2000" << std::endl;
+        std::cout << "option name Threads type spin default " << std::clamp((int)std::thread::hardware_concurrency(), 1, Bot::MAX_THREADS) << " min 1 max " << Bot::MAX_THREADS << std::endl;
         std::cout << "uciok" << std::endl;
     }
     else if (word == "ucinewgame") {
+        stopSearch();
         board->resetBoard();
         bot->reset();
 
@@ -87,7 +119,7 @@ void Engine::parseCommand(std::string command) {
         playMatch();
     }
     else if (word == "perft") {
-        runPerftTests(2);
+        parsePerftCommand(command);
     }
     else {
         perror("Received incorrect command");
@@ -102,6 +134,11 @@ void Engine::parseGoCommand(std::string command) {
     while (s >> word)
         words.push_back(word);
 
+    if (words.size() >= 2 && words[1] == "perft") {
+        perftDivide(words.size() >= 3 ? std::stoi(words[2]) : 1);
+        return;
+    }
+
     int thinkTime = -1;
 
     for (int i = 0; i < words.size(); i++) {
@@ -122,16 +159,19 @@ void Engine::parseGoCommand(std::string command) {
         }
     }
 
-    //TODO: get this working in a different thread so the main thread can be watching for the stop or quit command
+    //the search runs on the pool so the main thread can keep watching for the stop or quit command
+    if (bestMove.valid())
+        bestMove.wait();
+
     if (thinkTime == -1) {
-        bestMove = std::async(std::launch::async, [this](){
+        bestMove = threadPool.submit([this](){
             Move m = bot->getBestMove();
             std::cout << "bestmove " << m.toString() << std::endl;
             return m;
         });
     }
     else {
-        bestMove = std::async(std::launch::async, [this, thinkTime](){
+        bestMove = threadPool.submit([this, thinkTime](){
             Move m = bot->getBestMove(thinkTime);
             std::cout << "bestmove " << m.toString() << std::endl;
             return m;
@@ -168,7 +208,152 @@ void Engine::parsePositionCommand(std::string command) {
     for (Move m; i < words.size(); i++) {
         validateMove(m, words[i]);
         board->makeMove(m);
-        board->cleanup();
+    }
+}
+
+//perft [rigor | epd [file] [depth <max>]] [threads <count>] [split <depth>] [bulk] [hash <mb>]
+void Engine::parsePerftCommand(std::string command) {
+    std::vector<std::string> words;
+
+    std::stringstream s(command);
+    std::string word;
+    while (s >> word)
+        words.push_back(word);
+
+    int rigor = 2;
+    std::string suitePath;
+    int maxDepth = 6;
+
+    for (size_t i = 1; i < words.size(); i++) {
+        if (words[i] == "threads" && i+1 < words.size()) {
+            perftThreads = std::clamp(std::stoi(words[++i]), 1, Bot::MAX_THREADS);
+            reserveThreads(perftThreads);
+        }
+        else if (words[i] == "split" && i+1 < words.size()) {
+            perftSplitDepth = std::max(std::stoi(words[++i]), 0);
+        }
+        else if (words[i] == "bulk") {
+            perftBulkCounting = true;
+        }
+        else if (words[i] == "nobulk") {
+            perftBulkCounting = false;
+        }
+        else if (words[i] == "hash" && i+1 < words.size()) {
+            perftHashSizeMb = std::clamp(std::stoi(words[++i]), 0, TranspositionTable::MAX_SIZE_MB);
+        }
+        else if (words[i] == "epd") {
+            suitePath = RESOURCES_PATH "perft_suite.epd";
+            if (i+1 < words.size() && !std::isdigit(words[i+1][0]) && words[i+1] != "threads" && words[i+1] != "split"
+                && words[i+1] != "bulk" && words[i+1] != "nobulk" && words[i+1] != "hash" && words[i+1] != "depth")
+                suitePath = words[++i];
+        }
+        else if (words[i] == "depth" && i+1 < words.size()) {
+            maxDepth = std::stoi(words[++i]);
+        }
+        else if (std::isdigit(words[i][0])) {
+            rigor = std::clamp(std::stoi(words[i]), 1, 4);
+        }
+    }
+
+    if (suitePath.empty()) {
+        runPerftTests(rigor);
+        return;
+    }
+
+    std::vector<Perft::SuitePosition> suite;
+    if (!Perft::loadSuite(suitePath, suite)) {
+        std::cout << "Could not read perft suite: " << suitePath << std::endl;
+        return;
+    }
+
+    runPerftSuite(suite, maxDepth);
+}
+
+//stops any running search and waits for it to finish, before anything the search reads is changed
+void Engine::stopSearch() {
+    bot->stop();
+    if (bestMove.valid())
+        bestMove.wait();
+}
+
+//grows the thread pool to at least the given number of threads, waiting for any running search first
+void Engine::reserveThreads(int threadCount) {
+    if (threadCount <= threadPool.size())
+        return;
+
+    if (bestMove.valid())
+        bestMove.wait();
+    threadPool.resize(threadCount);
+}
+
+void Engine::parseSetOptionCommand(std::string command) {
+    //option names can contain spaces, so split on the name and value keywords instead of words
+    size_t nameIndex = command.find("name ");
+    size_t valueIndex = command.find(" value ");
+    if (nameIndex == std::string::npos)
+        return;
+
+    std::string name = command.substr(nameIndex + 5, valueIndex == std::string::npos ? std::string::npos : valueIndex - nameIndex - 5);
+    std::string value = valueIndex == std::string::npos ? "" : command.substr(valueIndex + 7);
+
+    if (name == "Hash") {
+        stopSearch();
+        bot->setHashSizeMb(std::clamp(std::stoi(value), 1, TranspositionTable::MAX_SIZE_MB));
+    }
+    else if (name == "PVS") {
+        bot->setUsePvs(value == "true");
+    }
+    else if (name == "AspirationWindows") {
+        bot->setUseAspirationWindows(value == "true");
+    }
+    else if (name == "NullMovePruning") {
+        bot->setUseNullMovePruning(value == "true");
+    }
+    else if (name == "NullMoveVerification") {
+        bot->setUseNullMoveVerification(value == "true");
+    }
+    else if (name == "LMR") {
+        bot->setUseLmr(value == "true");
+    }
+    else if (name == "LMP") {
+        bot->setUseLmp(value == "true");
+    }
+    else if (name == "LmrBase") {
+        bot->setLmrCoefficients(std::clamp(std::stoi(value), 0, 500), bot->getLmrDivisor());
+    }
+    else if (name == "LmrDivisor") {
+        bot->setLmrCoefficients(bot->getLmrBase(), std::clamp(std::stoi(value), 50, 1000));
+    }
+    else if (name == "LmpBase") {
+        bot->setLmpBase(std::clamp(std::stoi(value), 0, 64));
+    }
+    else if (name == "ReverseFutilityPruning") {
+        bot->setUseReverseFutilityPruning(value == "true");
+    }
+    else if (name == "FutilityPruning") {
+        bot->setUseFutilityPruning(value == "true");
+    }
+    else if (name == "Razoring") {
+        bot->setUseRazoring(value == "true");
+    }
+    else if (name == "DeltaPruning") {
+        bot->setUseDeltaPruning(value == "true");
+    }
+    else if (name == "RfpMargin") {
+        bot->setRfpMargin(std::clamp(std::stoi(value), 0, 1000));
+    }
+    else if (name == "FutilityMargin") {
+        bot->setFutilityMargin(std::clamp(std::stoi(value), 0, 1000));
+    }
+    else if (name == "RazorMargin") {
+        bot->setRazorMargin(std::clamp(std::stoi(value), 0, 2000));
+    }
+    else if (name == "Threads") {
+        bot->setThreadCount(std::stoi(value));
+        reserveThreads(std::clamp(std::stoi(value), 1, Bot::MAX_THREADS));
+    }
+    else {
+        perror("Received unknown option");
     }
 }
 
@@ -186,7 +371,6 @@ void Engine::playMatch() {
         Move move = (board->getWhiteTurn() == isBotWhite) ? bot->getBestMove() : getUserMove();
         previousMoves.push(move);
         board->makeMove(move);
-        board->cleanup();
         
         gameState = getCurrentGameState();
         if (gameState != GameState::Live) break;
@@ -228,9 +412,10 @@ void Engine::printASCIIBoard() {
  * @return the current game state
  */
 GameState Engine::getCurrentGameState() {
-    std::vector<Move> moves = MoveGeneration::generateMoves(*board);
+    MoveList moves;
+    MoveGeneration::generateMoves(*board, moves);
 
-    if (!moves.size())
+    if (moves.empty())
         return MoveGeneration::isKingTargeted(*board) ? GameState::Checkmate : GameState::Stalemate;
 
     return GameState::Live;
@@ -275,38 +460,40 @@ bool Engine::validateMove(Move& move, std::string moveString) {
     //extract start, end pos and promotionPiece as enums
     SquareIndex     startPos            = SquareIndex(8 * (startPosStr[0] - 'a') + (startPosStr[1] - '1'));
     SquareIndex     endPos              = SquareIndex(8 * (endPosStr[0]   - 'a') + (endPosStr[1]   - '1'));
-    PieceType::Enum promotionPiece      = PieceType::INVALID;
+    PromotionPiece  promotionPiece      = PromotionPiece::KNIGHT;
+    bool            promotionPieceGiven = promotionPieceStr.size();
 
-    if (promotionPieceStr.size()) {
+    if (promotionPieceGiven) {
         switch (promotionPieceStr[0]) {
-            case 'Q': case 'q': { promotionPiece = board->getWhiteTurn() ? PieceType::WHITE_QUEEN  : PieceType::BLACK_QUEEN;    break; }
-            case 'R': case 'r': { promotionPiece = board->getWhiteTurn() ? PieceType::WHITE_ROOK   : PieceType::BLACK_ROOK;     break; }
-            case 'B': case 'b': { promotionPiece = board->getWhiteTurn() ? PieceType::WHITE_BISHOP : PieceType::BLACK_BISHOP;   break; }
-            case 'K': case 'k': { promotionPiece = board->getWhiteTurn() ? PieceType::WHITE_KNIGHT : PieceType::BLACK_KNIGHT;   break; }
+            case 'Q': case 'q': { promotionPiece = PromotionPiece::QUEEN;   break; }
+            case 'R': case 'r': { promotionPiece = PromotionPiece::ROOK;    break; }
+            case 'B': case 'b': { promotionPiece = PromotionPiece::BISHOP;  break; }
+            case 'N': case 'n':
+            case 'K': case 'k': { promotionPiece = PromotionPiece::KNIGHT;  break; }
             default:            { return false; } //user has given invalid promotion piece
         }
     }
 
     //check for a valid move with the given start pos and end pos
-    std::vector<Move> moves = MoveGeneration::generateMoves(*board);
+    MoveList moves;
+    MoveGeneration::generateMoves(*board, moves);
     for (auto& i : moves) {
         //if start and end positions don't match
-        if (i.normalMove.startPos != startPos || i.normalMove.endPos != endPos)
+        if (i.getStartPos() != startPos || i.getEndPos() != endPos)
             continue;
 
-        bool isPromotionMove = i.flag == MoveType::PROMOTION;
-        bool promotionPieceGiven = promotionPiece != PieceType::INVALID;
+        bool isPromotionMove = i.getFlag() == MoveType::PROMOTION;
 
         //if there a promotion piece is given when it shouldn't be or vice versa
         if (isPromotionMove != promotionPieceGiven)
             return false;
 
-        //copy the move over
-        move = Move(i);
-        if (isPromotionMove)
-            move.promotionMove.newPieceType = promotionPiece;
+        //each promotion piece is its own move
+        if (isPromotionMove && i.getPromotionPiece() != promotionPiece)
+            continue;
 
         //found the correct move
+        move = i;
         return true;
     }
 
@@ -319,7 +506,9 @@ bool Engine::validateMove(Move& move, std::string moveString) {
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /**
- * Runs all perft tests outputting the results to the console
+ * Runs the built in perft suite, the depth of each position is chosen by the rigor
+ *
+ * @param rigor 1-4, each level running roughly 10-100 times the nodes of the last
  */
 void Engine::runPerftTests(int rigor) {
     std::array<std::string, 7> fens = {
@@ -332,7 +521,7 @@ void Engine::runPerftTests(int rigor) {
         "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10 "
     };
 
-    std::vector<std::vector<long>> expectedResults = {
+    std::vector<std::vector<uint64_t>> expectedResults = {
         { 20, 400, 8902, 197281,  4865609, 119060324, 3195901860, 84998978956, 2439530234167, 69352859712417, 2097651003696806, 62854969236701747, 1981066775000396239 },
         { 48, 2039, 97862, 4085603, 193690690, 8031647685 },
         { 14, 191, 2812, 43238, 674624, 11030083, 178633661, 3009794393  },
@@ -346,84 +535,125 @@ void Engine::runPerftTests(int rigor) {
     if      (rigor == 1) depths = {5, 4, 6, 4, 4, 4, 4}; //in the millions of nodes
     else if (rigor == 2) depths = {6, 5, 7, 5, 5, 5, 5}; //in the tens-hundreds of millions of nodes
     else if (rigor == 3) depths = {7, 6, 8, 6, 6, 5, 6}; //in the billions of nodes
+    else if (rigor == 4) depths = {8, 6, 8, 6, 6, 5, 7}; //in the tens-hundreds of billions of nodes, needs bulk counting and hashing
 
-
-    auto start = std::chrono::high_resolution_clock::now();
-    
+    std::vector<Perft::SuitePosition> suite(7);
     for (int i = 0; i < 7; i++) {
-        board->parseFen(fens[i]);
-        std::cout << "fen: " << fens[i] << '\n';
-
-        for (int j = 1; j <= depths[i]; j++) {
-            long nodes = perft(j);
-            std::cout << "depth: " << j << " nodes: " << nodes << '\n';
-            assert(nodes == expectedResults[i][j-1]);
-        }
-
-        std::cout << '\n';
+        suite[i].fen = fens[i];
+        for (int j = 1; j <= depths[i]; j++)
+            suite[i].counts.emplace_back(j, expectedResults[i][j-1]);
     }
 
-    auto end = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-    std::cout << "Time ellapsed (miliseconds): " << duration.count() << '\n';
+    runPerftSuite(suite, *std::max_element(depths.begin(), depths.end()));
 }
 
 /**
- * Runs perft up to a given depth on the current board
+ * Runs perft on every position of a suite, checking each count against the expected count
  * 
- * @param depth the depth to run up to
- * @return the total number of positions for the given depth
+ * Prints the nodes, time and Mnps of every depth and position, then the totals of each thread and of the suite
+ *
+ * @param suite the positions and their expected counts
+ * @param maxDepth the deepest count to check, deeper counts are skipped
+ * @return whether or not every count matched
  */
-uint64_t Engine::perft(int depth) {
-    std::vector<Move> moves;
-    uint64_t nodes = 0;
+bool Engine::runPerftSuite(const std::vector<Perft::SuitePosition>& suite, int maxDepth) {
+    Perft::HashTable* table = perftHashSizeMb ? new Perft::HashTable(perftHashSizeMb) : nullptr;
+    Perft::Options options = {perftBulkCounting, table};
 
-    if (depth == 0)
-        return  1ULL;
+    std::vector<Perft::ThreadStats> threadTotals(perftThreads);
+    uint64_t totalNodes = 0;
+    int failedPositions = 0;
 
-    moves = MoveGeneration::generateMoves(*board);
+    std::cout << "threads: " << perftThreads << " split depth: " << perftSplitDepth
+              << " bulk counting: " << (perftBulkCounting ? "on" : "off") << " hash (mb): " << perftHashSizeMb << "\n\n";
 
-    for (auto& i : moves) {
-        board->makeMove(i);
+    auto start = std::chrono::high_resolution_clock::now();
+    
+    for (const Perft::SuitePosition& position : suite) {
+        board->parseFen(position.fen);
+        std::cout << "fen: " << position.fen << '\n';
+
+        uint64_t positionNodes = 0;
+        double positionSeconds = 0;
+        bool passed = true;
+
+        for (auto [depth, expected] : position.counts) {
+            if (depth > maxDepth)
+                continue;
+
+            Perft::Result result = Perft::parallelPerft(threadPool, *board, depth, perftThreads, perftSplitDepth, options);
+            std::cout << "depth: " << depth << " nodes: " << result.nodes << " time (ms): " << (int)(result.seconds * 1000)
+                      << " Mnps: " << result.nodes / std::max(result.seconds, 1e-9) / 1e6;
+
+            if (result.nodes != expected) {
+                std::cout << " FAILED, expected: " << expected;
+                passed = false;
+            }
+            std::cout << '\n';
+
+            positionNodes += result.nodes;
+            positionSeconds += result.seconds;
+            for (int t = 0; t < perftThreads; t++) {
+                threadTotals[t].nodes += result.threads[t].nodes;
+                threadTotals[t].jobs += result.threads[t].jobs;
+                threadTotals[t].seconds += result.threads[t].seconds;
+            }
+        }
 
-        nodes += perft(depth -1);
+        std::cout << (passed ? "passed" : "FAILED") << " nodes: " << positionNodes << " time (ms): " << (int)(positionSeconds * 1000)
+                  << " Mnps: " << positionNodes / std::max(positionSeconds, 1e-9) / 1e6 << "\n\n";
 
-        board->unMakeMove(i);
+        totalNodes += positionNodes;
+        failedPositions += !passed;
     }
 
-    return nodes;
+    auto end = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    for (int t = 0; t < perftThreads; t++) {
+        const Perft::ThreadStats& stats = threadTotals[t];
+        std::cout << "thread " << t << ": nodes: " << stats.nodes << " jobs: " << stats.jobs
+                  << " Mnps: " << stats.nodes / std::max(stats.seconds, 1e-9) / 1e6 << '\n';
+    }
+
+    std::cout << "Positions passed: " << suite.size() - failedPositions << "/" << suite.size() << '\n';
+    std::cout << "Total nodes: " << totalNodes << " Mnps: " << totalNodes / seconds / 1e6 << '\n';
+    std::cout << "Time ellapsed (miliseconds): " << (int)(seconds * 1000) << std::endl;
+
+    delete table;
+    return failedPositions == 0;
 }
+
 /**
- * Runs perft up to a given depth on the current board, while printing out each node
+ * Runs perft to a given depth on the current board, printing the node count below each legal move
  * 
- * @param depth the depth to run up to
+ * @param depth the depth to run to
  * @return the total number of positions for the given depth
  */
 uint64_t Engine::perftDivide(int depth) {
-    std::vector<Move> moves;
-    std::vector<int> childMoveCount;
-    uint64_t nodes = 0;
+    Perft::HashTable* table = perftHashSizeMb ? new Perft::HashTable(perftHashSizeMb) : nullptr;
+    Perft::Options options = {perftBulkCounting, table};
 
-    if (depth == 0)
-        return  1ULL;
-
-    moves = MoveGeneration::generateMoves(*board);
+    MoveList moves;
+    uint64_t nodes = 0;
+    double seconds = 0;
 
-    for (auto& i : moves) {
-        board->makeMove(i);
+    if (depth > 0)
+        MoveGeneration::generateMoves(*board, moves);
 
-        uint64_t childMoves = perftDivide(depth -1);
-        nodes += childMoves;
-        childMoveCount.push_back(childMoves);
+    for (const Move& move : moves) {
+        board->makeMove(move);
+        Perft::Result result = Perft::parallelPerft(threadPool, *board, depth-1, perftThreads, perftSplitDepth, options);
+        board->unMakeMove(move);
 
-        board->unMakeMove(i);
+        std::cout << move.toString() << ": " << result.nodes << '\n';
+        nodes += result.nodes;
+        seconds += result.seconds;
     }
 
-    std::cout << "=============================== " << "depth: " << depth << " ===============================" << '\n';
-    for (int i = 0; i < moves.size(); i++) {
-        moves[i].print();
-        std::cout << "child moves: " << childMoveCount[i] << '\n' << '\n';
-    }
+    std::cout << "\nNodes searched: " << nodes << " time (ms): " << (int)(seconds * 1000)
+              << " Mnps: " << nodes / std::max(seconds, 1e-9) / 1e6 << std::endl;
 
+    delete table;
     return nodes;
 }
@@ -4,16 +4,50 @@
 #include <string>
 #include <iostream>
 #include <bitset>
+#include <cassert>
 
 #include "board/BoardUtil.hpp"
 #include "board/Move.hpp"
+#include "board/Zobrist.hpp"
 #include "moveGeneration/MoveGenerator.hpp"
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// * ----------------------------------------- [ STATIC MEMBERS ] ---------------------------------------- * //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//castling rights kept when a piece moves from or to each square
+static constexpr std::array<uint8_t, 64> castleRightsMask = []() {
+    std::array<uint8_t, 64> mask{};
+    mask.fill(ALL_CASTLE_RIGHTS);
+
+    mask[SquareIndex::a1] &= ~CASTLE_RIGHT(CastlePieces::W_QUEEN);
+    mask[SquareIndex::h1] &= ~CASTLE_RIGHT(CastlePieces::W_KING);
+    mask[SquareIndex::e1] &= ~(CASTLE_RIGHT(CastlePieces::W_KING) | CASTLE_RIGHT(CastlePieces::W_QUEEN));
+    mask[SquareIndex::a8] &= ~CASTLE_RIGHT(CastlePieces::B_QUEEN);
+    mask[SquareIndex::h8] &= ~CASTLE_RIGHT(CastlePieces::B_KING);
+    mask[SquareIndex::e8] &= ~(CASTLE_RIGHT(CastlePieces::B_KING) | CASTLE_RIGHT(CastlePieces::B_QUEEN));
+
+    return mask;
+}();
+
+//the rook squares of a castle, implied by the king move since the king always starts on the e file
+static inline SquareIndex castleRookStartPos(SquareIndex kingStartPos, SquareIndex kingEndPos) {
+    return (SquareIndex)(kingEndPos > kingStartPos ? kingStartPos + 24 : kingStartPos - 32);
+}
+static inline SquareIndex castleRookEndPos(SquareIndex kingStartPos, SquareIndex kingEndPos) {
+    return (SquareIndex)(kingEndPos > kingStartPos ? kingStartPos + 8 : kingStartPos - 8);
+}
+//the square of the pawn taken en passant, on the end file and the start rank
+static inline SquareIndex enPassantKillSquare(SquareIndex startPos, SquareIndex endPos) {
+    return (SquareIndex)((endPos & ~7) | (startPos & 7));
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // * ------------------------------------ [ CONSTRUCTORS/DESCTUCTOR ] ------------------------------------ * //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 Board::Board() {
+    stateHistory.reserve(256);
     setDefaultBoard();
 }
 
@@ -33,12 +67,6 @@ const std::array<uint64_t, 14>& Board::getBitBoards() const {
 const std::array<int, 64>& Board::getMailboxBoard() const {
     return mailBoxBoard;
 }
-const std::array<__uint128_t,  4>& Board::getCastleData() const {
-    return castleData;
-}
-const std::array<__uint128_t, 16>& Board::getEnPassantData() const {
-    return enPassantData;
-}
 //const getters
 PieceType::Enum Board::getType(SquareIndex index) const {
     return (PieceType::Enum)(mailBoxBoard[index]);
@@ -46,6 +74,19 @@ PieceType::Enum Board::getType(SquareIndex index) const {
 WhiteTurn Board::getWhiteTurn() const {
     return whiteTurn;
 }
+uint8_t Board::getCastlingRights() const {
+    return castlingRights;
+}
+SquareIndex Board::getEnPassantSquare() const {
+    return enPassantSquare;
+}
+uint64_t Board::getHash() const {
+    return hash;
+}
+//the piece captured by the last move, INVALID if it wasn't a capture or there is no last move
+PieceType::Enum Board::getLastCaptured() const {
+    return stateHistory.empty() ? PieceType::INVALID : stateHistory.back().killPieceType;
+}
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // * ----------------------------------------- [ PUBLIC METHODS ] ---------------------------------------- * //
@@ -54,103 +95,154 @@ WhiteTurn Board::getWhiteTurn() const {
 /**
  * Logic for making a move on the bitboards, and setting relevent flags
  * 
+ * The moving and captured pieces are read from the mailbox, the captured piece is saved for unMakeMove()
+ * 
  * @param move the move to be made
  */
 void Board::makeMove(const Move& move) {
+    const SquareIndex       startPos        = move.getStartPos();
+    const SquareIndex       endPos          = move.getEndPos();
+    const PieceType::Enum   pieceType       = getType(startPos);
+    PieceType::Enum         killPieceType   = getType(endPos);
+
+    stateHistory.push_back({hash, castlingRights, enPassantSquare, killPieceType});
+
     whiteTurn = !whiteTurn;
-    
-    for (auto& i : castleData) {
-        i <<= 1;
-    }
-    for (auto& i : enPassantData) {
-        i <<= 1;
+    hash ^= Zobrist::keys.blackTurn;
+
+    if (enPassantSquare != NO_SQUARE) {
+        hash ^= Zobrist::keys.enPassant[enPassantSquare / 8];
+        enPassantSquare = NO_SQUARE;
     }
     
-    switch (move.flag) {
-        case MoveType::CASTLE:
-            togglePiece(move.castleMove.primaryPieceType, move.castleMove.primaryStartPos);
-            togglePiece(move.castleMove.primaryPieceType, move.castleMove.primaryEndPos);
-            togglePiece(move.castleMove.secondaryPieceType, move.castleMove.secondaryStartPos);
-            togglePiece(move.castleMove.secondaryPieceType, move.castleMove.secondaryEndPos);
-            updateSpecialMoveStatus(move);
+    switch (move.getFlag()) {
+        case MoveType::CASTLE: {
+            const SquareIndex       rookStartPos    = castleRookStartPos(startPos, endPos);
+            const SquareIndex       rookEndPos      = castleRookEndPos(startPos, endPos);
+            const PieceType::Enum   rookType        = (PieceType::Enum)(PieceType::WHITE_ROOK + PIECE_COLOUR(pieceType));
+
+            togglePiece(pieceType, startPos);
+            togglePiece(pieceType, endPos);
+            togglePiece(rookType, rookStartPos);
+            togglePiece(rookType, rookEndPos);
+            updateSpecialMoveStatus(move, pieceType);
             break;
-            
-        case MoveType::EN_PASSANT:
-            togglePiece(move.enPassantMove.pieceType, move.enPassantMove.startPos);
-            togglePiece(move.enPassantMove.pieceType, move.enPassantMove.endPos);
-            togglePiece(move.enPassantMove.killPieceType, move.enPassantMove.killSquare);
+        }
+        case MoveType::EN_PASSANT: {
+            const SquareIndex killSquare = enPassantKillSquare(startPos, endPos);
+            killPieceType = getType(killSquare);
+            stateHistory.back().killPieceType = killPieceType;
+
+            togglePiece(pieceType, startPos);
+            togglePiece(pieceType, endPos);
+            togglePiece(killPieceType, killSquare);
             break;
-
+        }
         case MoveType::PROMOTION:
-            togglePiece(move.promotionMove.killPieceType, move.promotionMove.endPos);
-            togglePiece(move.promotionMove.oldPieceType, move.promotionMove.startPos);
-            togglePiece(move.promotionMove.newPieceType, move.promotionMove.endPos);
-            updateSpecialMoveStatus(move);
+            togglePiece(killPieceType, endPos);
+            togglePiece(pieceType, startPos);
+            togglePiece(move.getPromotionPieceType(PIECE_COLOUR(pieceType)), endPos);
+            updateSpecialMoveStatus(move, pieceType);
             break;
 
         case MoveType::NORMAL:
-            togglePiece(move.normalMove.killPieceType, move.normalMove.endPos);
-            togglePiece(move.normalMove.pieceType, move.normalMove.startPos);
-            togglePiece(move.normalMove.pieceType, move.normalMove.endPos);
-            updateSpecialMoveStatus(move);
+            togglePiece(killPieceType, endPos);
+            togglePiece(pieceType, startPos);
+            togglePiece(pieceType, endPos);
+            updateSpecialMoveStatus(move, pieceType);
             break;
     }
+
+    assert(hash == generateHash());
 }
 /**
  * Logic for unmaking a move on the bitboards, and unsetting relevent flags
  * 
- * @param move the move to be unmade
+ * @param move the move to be unmade, must be the last move made
  */
 void Board::unMakeMove(const Move& move) {
+    const SquareIndex       startPos        = move.getStartPos();
+    const SquareIndex       endPos          = move.getEndPos();
+    const PieceType::Enum   pieceType       = getType(endPos);
+    const StateInfo&        state           = stateHistory.back();
+
     whiteTurn = !whiteTurn;
 
-    for (auto& i : castleData) {
-        i >>= 1;
-    }
-    for (auto& i : enPassantData) {
-        i >>= 1;
-    }
+    switch (move.getFlag()) {
+        case MoveType::CASTLE: {
+            const PieceType::Enum rookType = (PieceType::Enum)(PieceType::WHITE_ROOK + PIECE_COLOUR(pieceType));
 
-    switch (move.flag) {
-        case MoveType::CASTLE:
-            togglePiece(move.castleMove.secondaryPieceType, move.castleMove.secondaryEndPos);
-            togglePiece(move.castleMove.secondaryPieceType, move.castleMove.secondaryStartPos);
-            togglePiece(move.castleMove.primaryPieceType, move.castleMove.primaryEndPos);
-            togglePiece(move.castleMove.primaryPieceType, move.castleMove.primaryStartPos);
+            togglePiece(rookType, castleRookEndPos(startPos, endPos));
+            togglePiece(rookType, castleRookStartPos(startPos, endPos));
+            togglePiece(pieceType, endPos);
+            togglePiece(pieceType, startPos);
             break;
+        }
         case MoveType::EN_PASSANT:
-            togglePiece(move.enPassantMove.killPieceType, move.enPassantMove.killSquare);
-            togglePiece(move.enPassantMove.pieceType, move.enPassantMove.endPos);
-            togglePiece(move.enPassantMove.pieceType, move.enPassantMove.startPos);
+            togglePiece(state.killPieceType, enPassantKillSquare(startPos, endPos));
+            togglePiece(pieceType, endPos);
+            togglePiece(pieceType, startPos);
             break;
         case MoveType::PROMOTION:
-            togglePiece(move.promotionMove.newPieceType, move.promotionMove.endPos);
-            togglePiece(move.promotionMove.oldPieceType, move.promotionMove.startPos);
-            togglePiece(move.promotionMove.killPieceType, move.promotionMove.endPos);
+            togglePiece(pieceType, endPos);
+            togglePiece((PieceType::Enum)(PieceType::WHITE_PAWN + PIECE_COLOUR(pieceType)), startPos);
+            togglePiece(state.killPieceType, endPos);
             break;
         case MoveType::NORMAL:
-            togglePiece(move.normalMove.pieceType, move.normalMove.endPos);
-            togglePiece(move.normalMove.pieceType, move.normalMove.startPos);
-            togglePiece(move.normalMove.killPieceType, move.normalMove.endPos);
+            togglePiece(pieceType, endPos);
+            togglePiece(pieceType, startPos);
+            togglePiece(state.killPieceType, endPos);
             break;
     }
+
+    hash = state.hash;
+    castlingRights = state.castlingRights;
+    enPassantSquare = state.enPassantSquare;
+    stateHistory.pop_back();
+
+    assert(hash == generateHash());
+}
+
+/**
+ * Passes the turn to the other side without moving a piece, used by null move pruning
+ * 
+ * Any en passant square is cleared as the chance to take it is given up
+ */
+void Board::makeNullMove() {
+    stateHistory.push_back({hash, castlingRights, enPassantSquare, PieceType::INVALID});
+
+    whiteTurn = !whiteTurn;
+    hash ^= Zobrist::keys.blackTurn;
+
+    if (enPassantSquare != NO_SQUARE) {
+        hash ^= Zobrist::keys.enPassant[enPassantSquare / 8];
+        enPassantSquare = NO_SQUARE;
+    }
+
+    assert(hash == generateHash());
 }
 
 /**
- * Used after completing a move, makes it so that there are no bit overflows after 64 full moves for castle data
- * Don't use if you need to go back a move for perft or minimax
+ * Unmakes a null move, which must be the last move made
  */
-void Board::cleanup() {
-    for (auto& rook : castleData)
-        if (rook) rook = 0b1;
+void Board::unMakeNullMove() {
+    const StateInfo& state = stateHistory.back();
+
+    whiteTurn = !whiteTurn;
+    hash = state.hash;
+    enPassantSquare = state.enPassantSquare;
+    stateHistory.pop_back();
+
+    assert(hash == generateHash());
 }
 
 /**
  * Sets up the board in its starting position
  */
 void Board::setDefaultBoard() {
-    enPassantData = {};
-    castleData = {};
+    enPassantSquare = NO_SQUARE;
+    castlingRights = ALL_CASTLE_RIGHTS;
+    stateHistory.clear();
     drawMoveCounter = 0;
     whiteTurn = true;
     
@@ -181,13 +273,16 @@ void Board::setDefaultBoard() {
         WHITE_KNIGHT, WHITE_PAWN, INVALID, INVALID, INVALID, INVALID, BLACK_PAWN, BLACK_KNIGHT,
         WHITE_ROOK,   WHITE_PAWN, INVALID, INVALID, INVALID, INVALID, BLACK_PAWN, BLACK_ROOK
     };
+
+    hash = generateHash();
 }
 /**
  * Resets the board back to its initial/default state
  */
 void Board::resetBoard() {
-    castleData = {1, 1, 1, 1};
-    enPassantData = {};
+    castlingRights = 0;
+    enPassantSquare = NO_SQUARE;
+    stateHistory.clear();
     bitBoards = {};
     for (int i = 0; i < 64; i++) mailBoxBoard[i] = PieceType::INVALID;
     drawMoveCounter = 0;
@@ -233,16 +328,15 @@ void Board::parseFen(const std::string& FEN) {
     for (i++; i < FEN.length(); i++) {
         if (FEN[i] == ' ') break;
 
-        if      (FEN[i] == 'K') castleData[CastlePieces::W_KING]    = 0;
-        else if (FEN[i] == 'Q') castleData[CastlePieces::W_QUEEN]   = 0;
-        else if (FEN[i] == 'k') castleData[CastlePieces::B_KING]    = 0;
-        else if (FEN[i] == 'q') castleData[CastlePieces::B_QUEEN]   = 0;
+        if      (FEN[i] == 'K') castlingRights |= CASTLE_RIGHT(CastlePieces::W_KING);
+        else if (FEN[i] == 'Q') castlingRights |= CASTLE_RIGHT(CastlePieces::W_QUEEN);
+        else if (FEN[i] == 'k') castlingRights |= CASTLE_RIGHT(CastlePieces::B_KING);
+        else if (FEN[i] == 'q') castlingRights |= CASTLE_RIGHT(CastlePieces::B_QUEEN);
     }
 
     //parses the fourth part of the FEN
     if (FEN[i+1] != '-') {
-        int index = (FEN[i+1] - 'a') + (FEN[i+2] =='3' ? 0 : 8);
-        enPassantData[(EnPassantPieces)(index)] = 1;
+        enPassantSquare = (SquareIndex)(8 * (FEN[i+1] - 'a') + (FEN[i+2] - '1'));
         i--;
     }
 
@@ -250,6 +344,8 @@ void Board::parseFen(const std::string& FEN) {
     for (i += 3; FEN[i] != ' '; i++) {
         drawMoveCounter = 10 *drawMoveCounter + (FEN[i]-'0');
     }
+
+    hash = generateHash();
 }
 
 std::string Board::toFen() {
@@ -290,23 +386,16 @@ std::string Board::toFen() {
     //add castle data
     fen += ' ';
     std::string rooks = "KQkq";
-    for (int i = 0; i < castleData.size(); i++)
-        if (!castleData[i]) fen += rooks[i];
+    for (int i = 0; i < rooks.size(); i++)
+        if (castlingRights & CASTLE_RIGHT(i)) fen += rooks[i];
     if (rooks.find(fen.back()) == -1) fen += '-';
     
-    //add en passant data
-    // fen += ' ';
-    // for (int i = 0; i < enPassantData.size(); i++) {
-        // if (enPassantData[i]&1) {
-            // fen += (i%8)+'a';
-            // fen += i < 8 ? '3' : '6';
-        // }
-    // }
-
     //add en passant data
     fen += ' ';
-    for (const Move& m : MoveGeneration::generateMoves(*this)) {
-        if (m.flag == EN_PASSANT) {
+    MoveList moves;
+    MoveGeneration::generateMoves(*this, moves);
+    for (const Move& m : moves) {
+        if (m.getFlag() == EN_PASSANT) {
             fen += m.toString().substr(2, 2);
             break;
         }
@@ -320,63 +409,58 @@ std::string Board::toFen() {
     return fen;
 }
 
+/**
+ * Calculates the zobrist hash of the board from scratch, used to set the hash after setting up a position
+ * and to check the incrementally updated hash against in debug builds
+ * 
+ * @return the zobrist hash of the board
+ */
+uint64_t Board::generateHash() const {
+    uint64_t key = 0;
+
+    for (int i = 0; i < 64; i++)
+        if (mailBoxBoard[i] != PieceType::INVALID)
+            key ^= Zobrist::keys.pieces[mailBoxBoard[i]][i];
+
+    key ^= Zobrist::keys.castling[castlingRights];
+
+    if (enPassantSquare != NO_SQUARE)
+        key ^= Zobrist::keys.enPassant[enPassantSquare / 8];
+
+    if (!whiteTurn)
+        key ^= Zobrist::keys.blackTurn;
+
+    return key;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // * ---------------------------------------- [ PRIVATE METHODS ] ---------------------------------------- * //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /**
- * Logic for determining which pieces can castle and which can en passant in a manor that can be undone with unMakeMove()
+ * Logic for determining which pieces can castle and which can en passant, the previous state is restored by unMakeMove()
  * 
  * @param move the move to be played
+ * @param pieceType the type of the moving piece
  */
-void Board::updateSpecialMoveStatus(const Move& move) {
-    //logic for determining which pieces can en passant and which can castle
-    switch (move.normalMove.pieceType) {
-        case PieceType::WHITE_PAWN:
-        case PieceType::BLACK_PAWN: {
-            int dist = move.normalMove.endPos - move.normalMove.startPos;
-            if (dist == 2 || dist == -2) {
-                int index = (move.normalMove.startPos / 8) + ((move.normalMove.startPos & 7) == 1 ? 0 : 8);
-                enPassantData[index] |= 0b1;
-            }
-            break;
-        }
-
-        case PieceType::WHITE_ROOK:
-        case PieceType::BLACK_ROOK: {
-            switch (move.normalMove.startPos) {
-                case SquareIndex::a1:   { castleData[CastlePieces::W_QUEEN] |= 0b1;  break; }
-                case SquareIndex::h1:   { castleData[CastlePieces::W_KING]  |= 0b1;  break; }
-                case SquareIndex::a8:   { castleData[CastlePieces::B_QUEEN] |= 0b1;  break; }
-                case SquareIndex::h8:   { castleData[CastlePieces::B_KING]  |= 0b1;  break; }
-                default:                { break; }
-            }
-            break;
-        }
-
-        case PieceType::WHITE_KING: {
-            castleData[CastlePieces::W_KING]     |= 0b1;
-            castleData[CastlePieces::W_QUEEN]    |= 0b1;
-            break;
-        }
-        case PieceType::BLACK_KING: {
-            castleData[CastlePieces::B_KING]     |= 0b1;
-            castleData[CastlePieces::B_QUEEN]    |= 0b1;
-            break;
-        }
-
-        default: {
-            break;
+void Board::updateSpecialMoveStatus(const Move& move, PieceType::Enum pieceType) {
+    const SquareIndex startPos  = move.getStartPos();
+    const SquareIndex endPos    = move.getEndPos();
+
+    //logic for determining if the pawn can be taken en passant
+    if (pieceType == PieceType::WHITE_PAWN || pieceType == PieceType::BLACK_PAWN) {
+        int dist = endPos - startPos;
+        if (dist == 2 || dist == -2) {
+            enPassantSquare = (SquareIndex)(startPos + dist / 2);
+            hash ^= Zobrist::keys.enPassant[enPassantSquare / 8];
         }
     }
 
-    //logic for determining if a rook has died and thus which pieces can castle    
-    switch (move.normalMove.endPos) {
-        case SquareIndex::a1:   { castleData[CastlePieces::W_QUEEN] |= 0b1;  break; }
-        case SquareIndex::h1:   { castleData[CastlePieces::W_KING]  |= 0b1;  break; }
-        case SquareIndex::a8:   { castleData[CastlePieces::B_QUEEN] |= 0b1;  break; }
-        case SquareIndex::h8:   { castleData[CastlePieces::B_KING]  |= 0b1;  break; }
-        default:                { break; }
+    //logic for determining which pieces can castle, moving from or to a king or rook square loses the right
+    uint8_t newCastlingRights = castlingRights & castleRightsMask[startPos] & castleRightsMask[endPos];
+    if (newCastlingRights != castlingRights) {
+        hash ^= Zobrist::keys.castling[castlingRights] ^ Zobrist::keys.castling[newCastlingRights];
+        castlingRights = newCastlingRights;
     }
 }
 
@@ -397,6 +481,7 @@ void Board::removePiece(PieceType::Enum type, SquareIndex index) {
 //toggles a piece in a given square
 void Board::togglePiece(PieceType::Enum type, SquareIndex index) {
     if (type == PieceType::INVALID) return;
+    hash ^= Zobrist::keys.pieces[type][index];
     bitBoards[type] ^= (1ULL << index);
     bitBoards[PIECE_COLOUR(type) == PieceType::WHITE ? PieceType::WHITE_PIECES : PieceType::BLACK_PIECES] ^= (1ULL << index);
     mailBoxBoard[index] = (mailBoxBoard[index] == PieceType::INVALID) ? type : PieceType::INVALID;
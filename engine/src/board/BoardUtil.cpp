@@ -57,52 +57,3 @@ uint64_t southEastOne(uint64_t board) {
 uint64_t southWestOne(uint64_t board) {
     return (board >> 9) & 0x007F7F7F7F7F7F7FULL;
 }
-
-// * ------------------------------------ [ DIRECTION RAY FUNCTIONS ] ------------------------------------ * //
-
-//returns all square in a specific orthoganol direction given a square
-uint64_t calcNorthMask(SquareIndex square) {
-    return 2 * ((1ULL << (square|7)) - (1ULL << square));
-}
-uint64_t calcEastMask(SquareIndex square) {
-    return 0x0101010101010100ULL << square;
-}
-uint64_t calcSouthMask(SquareIndex square) {
-    return (1ULL << square) - (1ULL << (square & 56));
-}
-uint64_t calcWestMask(SquareIndex square) {
-    return 0x0080808080808080ULL >> (square ^ 63);
-}
-
-uint64_t calcNorthEastMask(SquareIndex square){ 
-    uint64_t diagonal = 0x8040201008040200ULL << (uint64_t)square;
-
-    int n = (square & 7) + 1; //x%8 === x&7
-    uint64_t mask = 0x0101010101010101ULL * ((1ULL << n) -1);
-
-    return diagonal & ~mask;
-}
-uint64_t calcNorthWestMask(SquareIndex square){
-    uint64_t diagonal = 0x0102040810204000ULL >> (square ^ 63);
-
-    int n = (square & 7) + 1; //x%8 === x&7
-    uint64_t mask = 0x0101010101010101ULL * ((1ULL << n) -1);
-
-    return diagonal & ~mask;
-}
-uint64_t calcSouthEastMask(SquareIndex square){ 
-    uint64_t diagonal = 0x0002040810204080ULL << square;
-
-    int n = (square & 7) + 1; //x%8 === x&7
-    uint64_t mask = 0x0101010101010101ULL * ((1ULL << n) -1);
-
-    return diagonal & mask;
-}
-uint64_t calcSouthWestMask(SquareIndex square){ 
-    uint64_t diagonal = 0x0040201008040201ULL >> (square ^ 63);
-
-    int n = (square & 7) + 1; //x%8 === x&7
-    uint64_t mask = 0x0101010101010101ULL * ((1ULL << n) -1);
-
-    return diagonal & mask;
-}
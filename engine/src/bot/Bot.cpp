@@ -1,10 +1,11 @@
 #include "bot/Bot.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <climits>
+#include <cmath>
 #include <cstdlib>
-#include <cstring>
 #include <fstream>
 #include <future>
 #include <iostream>
@@ -17,14 +18,14 @@
 #include "bot/PrincipalVariation.hpp"
 #include "moveGeneration/MoveGenerator.hpp"
 #include "bot/Eval.hpp"
+#include "bot/MovePicker.hpp"
+#include "bot/See.hpp"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // * ----------------------------------------- [ STATIC MEMBERS ] ---------------------------------------- * //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 bool Bot::isPestoInitialised = false;
-const int Bot::NUM_THREADS = std::thread::hardware_concurrency();
-std::counting_semaphore<> Bot::threadsAvailable(NUM_THREADS);
 
 const std::string Bot::OPENING_BOOKS[] = {
     "opening_book_21_moves.epd","opening_book_16_moves.epd", "opening_book_14_moves.epd", "opening_book_13_moves.epd", "opening_book_12_moves.epd", "opening_book_11_moves.epd",
@@ -32,11 +33,24 @@ const std::string Bot::OPENING_BOOKS[] = {
     "opening_book_4_moves.epd", "opening_book_3_moves.epd"
 };
 
+//helper threads skip the depths where ((depth + phase) / size) is odd, so that they spread out over different depths
+static const int SKIP_SIZE[]  = {1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4};
+static const int SKIP_PHASE[] = {0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7};
+
+static void updateHistory(int& entry, int bonus, int max);
+static int scoreToTT(int score, int ply);
+static int scoreFromTT(int score, int ply);
+static int captureGain(const Board& board, const Move& move);
+static bool hasNonPawnMaterial(const Board& board);
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // * ------------------------------------ [ CONSTRUCTORS/DESCTUCTOR ] ------------------------------------ * //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-Bot::Bot(Board& board) : board(board), SEARCH_TIMER_NODE_FREQUENCY(1024) {
+Bot::Bot(Board& board, ThreadPool& threadPool) : board(board), threadPool(threadPool), transpositionTable(TranspositionTable::DEFAULT_SIZE_MB), SEARCH_TIMER_NODE_FREQUENCY(1024) {
+    threadCount = std::clamp((int)std::thread::hardware_concurrency(), 1, MAX_THREADS);
+    setLmrCoefficients(DEFAULT_LMR_BASE, DEFAULT_LMR_DIVISOR);
+
     if (!isPestoInitialised) {
         isPestoInitialised = true;
         Eval::initPestoTables();
@@ -61,12 +75,92 @@ void Bot::setTimeIncrementMs(int time) {
     timeIncrement = time;
 }
 
+void Bot::setHashSizeMb(int sizeMb) {
+    transpositionTable.resize(sizeMb);
+}
+
+void Bot::setThreadCount(int count) {
+    threadCount = std::clamp(count, 1, MAX_THREADS);
+}
+
+void Bot::setUsePvs(bool enabled) {
+    usePvs = enabled;
+}
+
+void Bot::setUseAspirationWindows(bool enabled) {
+    useAspirationWindows = enabled;
+}
+
+void Bot::setUseNullMovePruning(bool enabled) {
+    useNullMovePruning = enabled;
+}
+
+void Bot::setUseNullMoveVerification(bool enabled) {
+    useNullMoveVerification = enabled;
+}
+
+void Bot::setUseLmr(bool enabled) {
+    useLmr = enabled;
+}
+
+void Bot::setUseLmp(bool enabled) {
+    useLmp = enabled;
+}
+
+void Bot::setUseReverseFutilityPruning(bool enabled) {
+    useReverseFutilityPruning = enabled;
+}
+
+void Bot::setUseFutilityPruning(bool enabled) {
+    useFutilityPruning = enabled;
+}
+
+void Bot::setUseRazoring(bool enabled) {
+    useRazoring = enabled;
+}
+
+void Bot::setUseDeltaPruning(bool enabled) {
+    useDeltaPruning = enabled;
+}
+
+/**
+ * Sets the coefficients of the late move reduction table and rebuilds it, the reduction at a given depth and move index is
+ * base + log(depth) * log(moveIndex) / divisor plies. Must not be called during a search
+ *
+ * @param base the base reduction in hundredths of a ply
+ * @param divisor the divisor in hundredths
+ */
+void Bot::setLmrCoefficients(int base, int divisor) {
+    lmrBase = base;
+    lmrDivisor = std::max(divisor, 1);
+
+    for (int depth = 0; depth < LMR_TABLE_DEPTH; depth++)
+        for (int i = 0; i < MoveList::MAX_MOVES; i++)
+            lmrReductions[depth][i] = (depth == 0 || i == 0) ? 0 : (int)(lmrBase / 100.0 + std::log(depth) * std::log(i) / (lmrDivisor / 100.0));
+}
+
+void Bot::setLmpBase(int base) {
+    lmpBase = std::max(base, 0);
+}
+
+void Bot::setRfpMargin(int margin) {
+    rfpMargin = std::max(margin, 0);
+}
+
+void Bot::setFutilityMargin(int margin) {
+    futilityMargin = std::max(margin, 0);
+}
+
+void Bot::setRazorMargin(int margin) {
+    razorMargin = std::max(margin, 0);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // * ----------------------------------------- [ PUBLIC METHODS ] ---------------------------------------- * //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 Move Bot::getBestMove() {
-    forcedStop.store(false);
+    searchStopped.store(false);
     
     float factor = 0.07;
     if      (movesPlayed < 15) factor = 0.02;
@@ -81,7 +175,7 @@ Move Bot::getBestMove() {
 }
 
 Move Bot::getBestMove(int allocatedTime) {
-    forcedStop.store(false);
+    searchStopped.store(false);
 
     thinkTime = std::chrono::milliseconds(allocatedTime);
 
@@ -96,10 +190,11 @@ void Bot::reset() {
     movesOutOfBook = 0;
     movesPlayed = 0;
     timeLeftMs = 600000;
+    transpositionTable.clear();
 }
 
 void Bot::stop() {
-    forcedStop.store(true);
+    searchStopped.store(true);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -110,12 +205,12 @@ void Bot::stop() {
  * Conducts searching and evaluation in order to find and return the predicted best possible move
  * given the current board state
  * 
- * @return the best move
+ * @return the best move, or the null move if the side to move is mated or stalemated
  */
 Move Bot::calcBestMove() {   
     nodesSearched = 0;
-    searchDeadlineReached = false;
-    searchDeadline = thinkTime + std::chrono::high_resolution_clock::now();
+    searchStart = std::chrono::high_resolution_clock::now();
+    searchDeadline = thinkTime + searchStart;
     
     movesPlayed++;
     
@@ -126,70 +221,345 @@ Move Bot::calcBestMove() {
 
     movesOutOfBook++;
 
-    for (int i = 1;; i++) {
-        pVariation pvLine;
-        if (negaMax(i, -INT_MAX, INT_MAX, pvLine) == Eval::CHEKMATE_ABSOLUTE_SCORE)
-            return pvLine.moves[0];
-        if (searchDeadlineReached || forcedStop.load())
-            return principalVariation.moves[0];
+    //a mated or stalemated root has nothing to search, iterating would only repeat the same empty result
+    MoveList rootMoves;
+    MoveGeneration::generateMoves(board, rootMoves);
+    if (rootMoves.empty()) {
+        principalVariation.moveCount = 0;
+        std::cout << "info depth 0 score " << (MoveGeneration::isKingTargeted(board) ? "mate 0" : "cp 0") << std::endl;
+        return Move();
+    }
+
+    transpositionTable.newSearch();
+
+    //lazy smp, every thread runs its own iterative deepening and they only cooperate through the transposition table
+    searchThreads.clear();
+    for (int i = 0; i < threadCount; i++)
+        searchThreads.emplace_back(i, board);
+
+    std::vector<std::future<void>> helpers;
+    for (int i = 1; i < threadCount; i++)
+        helpers.push_back(threadPool.submit([this, &thread = searchThreads[i]](){ iterativeDeepening(thread); }));
+
+    iterativeDeepening(searchThreads[0]);
+
+    searchStopped.store(true);
+    for (std::future<void>& helper : helpers)
+        threadPool.waitFor(helper);
+
+    for (const SearchThread& thread : searchThreads)
+        nodesSearched += thread.nodes.load(std::memory_order_relaxed);
+
+    //the main thread reports the best move, falling back to any legal move if not even depth 1 finished
+    principalVariation = searchThreads[0].pv;
+    if (principalVariation.moveCount > 0)
+        return principalVariation.moves[0];
+
+    return rootMoves[0];
+}
+
+/**
+ * Runs iterative deepening on a search thread until the search is stopped, a mate is found, or the pv is full
+ *
+ * Helper threads skip some depths based on their id, so that they aren't all searching the same depth at once
+ *
+ * @param thread the search thread
+ */
+void Bot::iterativeDeepening(SearchThread& thread) {
+    for (int depth = 1; depth <= MAX_PLY / 2; depth++) {
+        if (thread.id > 0) {
+            int i = (thread.id - 1) % 20;
+            if (((depth + SKIP_PHASE[i]) / SKIP_SIZE[i]) % 2)
+                continue;
+        }
 
-        principalVariation = pvLine;
+        thread.rootDepth = depth;
+        thread.selDepth = 0;
+        thread.maxQDepth = 0;
+
+        int eval = aspirationSearch(thread, depth);
+        if (searchStopped.load())
+            return;
+
+        thread.pvTable.copyRoot(thread.pv);
+        thread.score = eval;
+        thread.completedDepth = depth;
+
+        if (thread.id == 0)
+            printInfo(thread);
+
+        //a mate found within the full width depth can't be bettered by searching deeper
+        if (Eval::isMateScore(eval) && Eval::CHEKMATE_ABSOLUTE_SCORE - std::abs(eval) <= depth)
+            break;
     }
+
+    //nothing left for the other threads to do once the main thread is done
+    if (thread.id == 0)
+        searchStopped.store(true);
 }
 
-int Bot::negaMax(int depth, int alpha, int beta, pVariation& parentLine) {
-    if (forcedStop.load()) return beta;
-    if (searchDeadlineReached || (++nodesSearched % SEARCH_TIMER_NODE_FREQUENCY == 0 && checkTimer())) return beta; //effectively snipping this branch like in alpha-beta
-    
-    if (depth == 0) return quiescence(alpha, beta);
+/**
+ * Searches the root to a given depth inside a window around the score of the previous iteration, widening the
+ * window on the side that failed until the score lands inside it
+ *
+ * @param thread the search thread
+ * @param depth the depth to search to
+ * @return the score of the root, only valid if the search wasn't stopped
+ */
+int Bot::aspirationSearch(SearchThread& thread, int depth) {
+    int delta = ASPIRATION_WINDOW;
+    int alpha = -INT_MAX;
+    int beta = INT_MAX;
+
+    //the scores of the first few iterations are too unstable to centre a window on
+    if (useAspirationWindows && depth >= 4) {
+        alpha = std::max(thread.score - delta, -INT_MAX);
+        beta = std::min(thread.score + delta, INT_MAX);
+    }
+
+    for (;;) {
+        int eval = negaMax(thread, depth, 0, alpha, beta);
+        if (searchStopped.load())
+            return eval;
+
+        delta *= 2;
+        bool fullWindow = delta > ASPIRATION_MAX_WINDOW;
 
-    std::vector<Move> moves = MoveGeneration::generateMoves(board);
-    if (!moves.size()) return Eval::terminalNodeEval(board);
-    orderMoves(moves);
+        if (eval <= alpha && alpha > -INT_MAX)
+            alpha = fullWindow ? -INT_MAX : std::max(eval - delta, -INT_MAX);
+        else if (eval >= beta && beta < INT_MAX)
+            beta = fullWindow ? INT_MAX : std::min(eval + delta, INT_MAX);
+        else
+            return eval;
+    }
+}
 
-    pVariation childLine;
+int Bot::negaMax(SearchThread& thread, int depth, int ply, int alpha, int beta, bool allowNullMove) {
+    thread.pvTable.clear(ply); //every return before a move raises alpha leaves an empty line
+    if (searchStopped.load(std::memory_order_relaxed)) return beta; //effectively snipping this branch like in alpha-beta
+    if (depth == 0) return quiescence(thread, ply, 0, alpha, beta);
 
-    for (const Move& move : moves) {
-        board.makeMove(move);
+    thread.countNode();
+    if (pollTimer(thread)) return beta;
 
-        int eval = -negaMax(depth-1, -beta, -alpha, childLine);
+    Board& b = thread.board;
+
+    //extensions can only take a line to twice the root depth, so this only guards the ply indexed tables
+    if (ply >= MAX_PLY)
+        return std::clamp(Eval::pestoEval(b), alpha, beta);
+
+    //mate distance pruning, no line from here can do better than mating next move or worse than being mated now
+    if (ply > 0) {
+        alpha = std::max(alpha, -Eval::CHEKMATE_ABSOLUTE_SCORE + ply);
+        beta = std::min(beta, Eval::CHEKMATE_ABSOLUTE_SCORE - ply - 1);
+        if (alpha >= beta)
+            return alpha;
+    }
+
+    //use the result of a previous search of this position if it was deep enough, never at the root as we need its pv
+    const uint64_t hash = b.getHash();
+    uint16_t hashMove = 0;
+
+    TTEntry entry;
+    if (transpositionTable.probe(hash, entry)) {
+        hashMove = entry.move;
+        entry.score = scoreFromTT(entry.score, ply);
+
+        if (ply > 0 && entry.depth >= depth) {
+            if ((entry.bound == Bound::EXACT) ||
+                (entry.bound == Bound::LOWER && entry.score >= beta) ||
+                (entry.bound == Bound::UPPER && entry.score <= alpha)) {
+                return std::clamp(entry.score, alpha, beta);
+            }
+        }
+    }
+
+    const bool inCheck = MoveGeneration::isKingTargeted(b);
+    const bool isPvNode = alpha + 1 < beta; //not beta - alpha, which overflows for the full root window
+
+    //forward pruning trusts the static eval of the node, so it is left out of pv nodes, checks and mating lines
+    const int staticEval = inCheck ? 0 : Eval::pestoEval(b);
+    const bool canPrune = !isPvNode && !inCheck && ply > 0 && !Eval::isMateScore(alpha) && !Eval::isMateScore(beta);
+
+    //reverse futility pruning, a shallow node this far above beta would need the opponent to win back more than the
+    //margin in the few plies left
+    if (useReverseFutilityPruning && canPrune && depth <= RFP_MAX_DEPTH && staticEval - rfpMargin * depth >= beta)
+        return beta;
+
+    //razoring, a shallow node this far below alpha is only searched further if quiescence finds a tactic to lift it
+    if (useRazoring && canPrune && depth <= RAZOR_MAX_DEPTH && staticEval + razorMargin * depth < alpha
+        && quiescence(thread, ply, 0, alpha-1, alpha) < alpha)
+        return alpha;
+
+    //null move pruning, if passing the turn still fails high then a real move almost certainly would too. Not safe
+    //in check, or in zugzwang which is only likely when the side to move has nothing but pawns
+    if (useNullMovePruning && allowNullMove && ply > 0 && depth >= NULL_MOVE_MIN_DEPTH
+        && hasNonPawnMaterial(b) && !inCheck && staticEval >= beta) {
+        const int reduction = depth > 6 ? 3 : 2;
+        const int nullDepth = std::max(depth - 1 - reduction, 0);
+
+        thread.moveStack[ply] = Move();
+        thread.extensionCarry[ply+1] = thread.extensionCarry[ply];
+        b.makeNullMove();
+        int eval = -negaMax(thread, nullDepth, ply+1, -beta, -beta+1, false);
+        b.unMakeNullMove();
+
+        if (searchStopped.load(std::memory_order_relaxed)) return beta;
+
+        //the verification search looks for zugzwang with a real move, at the same reduced depth without null moves
+        if (eval >= beta && useNullMoveVerification && nullDepth > 0)
+            eval = negaMax(thread, nullDepth, ply, beta-1, beta, false);
+
+        if (eval >= beta)
+            return beta;
+    }
+
+    Move counterMove;
+    if (ply > 0 && thread.moveStack[ply-1].pack()) {
+        const Move& previous = thread.moveStack[ply-1];
+        counterMove = thread.counterMoves[b.getType(previous.getEndPos())][previous.getEndPos()];
+    }
+
+    const int colour = b.getWhiteTurn() ? PieceType::WHITE : PieceType::BLACK;
+    MovePicker picker(b, hashMove, thread.killers[ply], counterMove, thread.history[colour], inCheck);
+
+    uint16_t bestMove = 0;
+    Bound bound = Bound::UPPER;
+
+    const int lmpMoveCount = lmpBase + depth * depth;
+
+    //futility pruning, at a frontier node this far below alpha only captures and checks are worth searching
+    const bool isFutile = useFutilityPruning && canPrune && depth <= FUTILITY_MAX_DEPTH && staticEval + futilityMargin * depth <= alpha;
+
+    Move quietsTried[MoveList::MAX_MOVES];
+    int quietCount = 0;
+
+    int moveCount = 0;
+    for (Move move; (move = picker.next()).pack();) {
+        const int i = moveCount++;
+        const bool isKiller = move == thread.killers[ply][0] || move == thread.killers[ply][1];
+        const bool isQuiet = b.getType(move.getEndPos()) == PieceType::INVALID
+                          && move.getFlag() != MoveType::PROMOTION && move.getFlag() != MoveType::EN_PASSANT;
+
+        //lmp, with good ordering the late quiet moves of a shallow non pv node are very unlikely to raise alpha
+        if (useLmp && !isPvNode && !inCheck && isQuiet && depth <= LMP_MAX_DEPTH && i >= lmpMoveCount)
+            continue;
+
+        const Move& previous = thread.moveStack[ply > 0 ? ply-1 : 0];
+        const bool isRecapture = ply > 0 && previous.pack() && b.getLastCaptured() != PieceType::INVALID
+                              && !isQuiet && move.getEndPos() == previous.getEndPos();
+        const bool isPawnToSeventh = b.getType(move.getStartPos()) / 2 == PieceType::WHITE_PAWN / 2
+                                  && (move.getEndPos() & 7) == (b.getWhiteTurn() ? 6 : 1);
+
+        thread.moveStack[ply] = move;
+        b.makeMove(move);
+
+        const bool givesCheck = MoveGeneration::isKingTargeted(b);
+
+        if (isFutile && i > 0 && isQuiet && !givesCheck) {
+            b.unMakeMove(move);
+            continue;
+        }
+
+        //extensions, forcing moves are searched deeper so the line isn't cut off in the middle. Fractions of a ply are
+        //carried down the line, and at most one whole ply is added per move
+        int extensionUnits = thread.extensionCarry[ply];
+        if (ply < 2 * thread.rootDepth) {
+            if (givesCheck)         extensionUnits += CHECK_EXTENSION;
+            if (isRecapture)        extensionUnits += RECAPTURE_EXTENSION;
+            if (isPawnToSeventh)    extensionUnits += PAWN_SEVENTH_EXTENSION;
+        }
+        const int extension = std::min(extensionUnits / ONE_PLY, 1);
+        const int newDepth = depth - 1 + extension;
+        thread.extensionCarry[ply+1] = std::min(extensionUnits - extension * ONE_PLY, ONE_PLY - 1);
+
+        //lmr, late quiet moves that aren't killers and don't give check are first searched shallower, then at full depth if they beat alpha
+        int reduction = 0;
+        if (useLmr && depth >= LMR_MIN_DEPTH && i >= LMR_MIN_MOVE_INDEX && isQuiet && !isKiller && !inCheck && !givesCheck)
+            reduction = std::clamp(lmrReductions[std::min(depth, LMR_TABLE_DEPTH-1)][i], 0, depth-2);
+
+        //pvs, assume the first move is the best and only prove the rest can't beat it with a null window,
+        //searching them again with the full window if they do
+        int eval = alpha + 1; //anything above alpha, so the first search that applies always runs
+        if (i > 0 && reduction > 0)
+            eval = -negaMax(thread, newDepth-reduction, ply+1, -alpha-1, -alpha);
+        if (i > 0 && usePvs && eval > alpha)
+            eval = -negaMax(thread, newDepth, ply+1, -alpha-1, -alpha);
+        if (i == 0 || (eval > alpha && (!usePvs || eval < beta)))
+            eval = -negaMax(thread, newDepth, ply+1, -beta, -alpha);
         
-        board.unMakeMove(move);
+        b.unMakeMove(move);
+
+        if (searchStopped.load(std::memory_order_relaxed)) return beta; //don't store or use the result of an unfinished search
 
         if (eval >= beta) {
+            if (isQuiet)
+                updateQuietHeuristics(thread, ply, depth, move, quietsTried, quietCount);
+
+            transpositionTable.store(hash, depth, scoreToTT(beta, ply), Bound::LOWER, move.pack());
             return beta;
         }
+        if (isQuiet)
+            quietsTried[quietCount++] = move;
         if (eval > alpha) {
             alpha = eval;
+            bestMove = move.pack();
+            bound = Bound::EXACT;
 
-            parentLine.moves[0] = move;
-            memcpy(parentLine.moves+1, childLine.moves, childLine.moveCount * sizeof(Move));
-            parentLine.moveCount = childLine.moveCount + 1;
+            thread.pvTable.update(ply, move);
         }
     }
 
+    if (moveCount == 0) return Eval::terminalNodeEval(b, ply);
+
+    transpositionTable.store(hash, depth, scoreToTT(alpha, ply), bound, bestMove);
     return alpha;
 }
 
 //credit due to the chess programming wiki for this function
-int Bot::quiescence(int alpha, int beta) {
-    int staticEval = Eval::pestoEval(board);
-
-    int bestValue = staticEval;
-    if (bestValue >= beta)
-        return bestValue;
-    if  (bestValue > alpha)
-        alpha = bestValue;
+int Bot::quiescence(SearchThread& thread, int ply, int qDepth, int alpha, int beta) {
+    if (searchStopped.load(std::memory_order_relaxed)) return beta;
+
+    Board& b = thread.board;
+
+    thread.countNode();
+    thread.qNodes++;
+    if (pollTimer(thread)) return beta;
+    thread.selDepth = std::max(thread.selDepth, ply);
+    thread.maxQDepth = std::max(thread.maxQDepth, qDepth);
+
+    const bool inCheck = MoveGeneration::isKingTargeted(b);
+    const int colour = b.getWhiteTurn() ? PieceType::WHITE : PieceType::BLACK;
+    MovePicker picker(b, thread.history[colour], inCheck, qDepth == 0);
+
+    //in check there is no standing pat, every evasion has to be searched. Otherwise only captures that don't lose
+    //material are, and quiet checks on the first ply of quiescence
+    int bestValue = -Eval::CHEKMATE_ABSOLUTE_SCORE + ply;
+    if (!inCheck) {
+        bestValue = Eval::pestoEval(b);
+        if (bestValue >= beta)
+            return bestValue;
+        if  (bestValue > alpha)
+            alpha = bestValue;
+
+        //delta pruning, if winning a queen and promoting another can't reach alpha then no capture will
+        const uint64_t pawnsOnSeventh = b.getBitBoards()[PieceType::WHITE_PAWN + colour] & (colour == PieceType::WHITE ? 0x4040404040404040ULL : 0x0202020202020202ULL);
+        const int maxGain = SEE::PIECE_VALUES[4] + (pawnsOnSeventh ? SEE::PIECE_VALUES[4] - SEE::PIECE_VALUES[0] : 0);
+        if (useDeltaPruning && bestValue + maxGain + DELTA_MARGIN < alpha)
+            return bestValue;
+    }
 
-    std::vector<Move> moves = MoveGeneration::generateMoves(board);
-    if (moves.size()) orderMovesQuiescence(moves);
+    int moveCount = 0;
+    for (Move move; (move = picker.next()).pack(); moveCount++) {
+        //and skip each capture that can't reach alpha even if it wins its victim for free
+        if (useDeltaPruning && !inCheck && picker.getStage() != MovePicker::QUIET_CHECKS && bestValue + captureGain(b, move) + DELTA_MARGIN <= alpha)
+            continue;
 
-    for (const Move& move : moves) {
-        board.makeMove(move);
+        b.makeMove(move);
 
-        int eval = -quiescence(-beta, -alpha);
+        int eval = -quiescence(thread, ply+1, qDepth+1, -beta, -alpha);
 
-        board.unMakeMove(move);
+        b.unMakeMove(move);
 
         if (eval >= beta)
             return eval;
@@ -199,6 +569,8 @@ int Bot::quiescence(int alpha, int beta) {
             alpha = eval;
     }
 
+    if (inCheck && moveCount == 0) return Eval::terminalNodeEval(b, ply);
+
     return bestValue;
 }
 
@@ -206,7 +578,8 @@ bool Bot::queryOpeningBook(std::string bookName, Move& move) {
     std::ifstream book(RESOURCES_PATH + bookName);
     if (!book.is_open()) return false;
     
-    std::vector<Move> moves = MoveGeneration::generateMoves(board);
+    MoveList moves;
+    MoveGeneration::generateMoves(board, moves);
     std::vector<Move> bookMoves;
 
     for (const auto& m : moves) {
@@ -235,124 +608,115 @@ bool Bot::queryOpeningBook(std::string bookName, Move& move) {
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// * -------------------------------------- [ CONCURRENCY METHODS ] -------------------------------------- * //
+// * ----------------------------------------- [ HELPER METHODS ] ---------------------------------------- * //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-int Bot::negaMaxConcurrent(int depth, int alpha, int beta, pVariation& parentLine, Board b) {
-    if (forcedStop.load()) return beta;
-    if (searchDeadlineReached || (++nodesSearched % SEARCH_TIMER_NODE_FREQUENCY == 0 && checkTimer())) return beta; //effectively snipping this branch like in alpha-beta
-    
-    if (depth == 0) return quiescence(alpha, beta, b);
-
-    std::vector<Move> moves = MoveGeneration::generateMoves(b);
-    if (!moves.size()) return Eval::terminalNodeEval(b);
-    orderMoves(moves);
-
-    pVariation childLine;
-
-    //thread stuff
-    std::vector<std::future<int>> threads(moves.size());
-
-    for (int i = 0, max = moves.size();;) {
-        while (threadsAvailable.try_acquire()) {
-            int index = i++;
-            if (index >= max) break;
-            Board bb(b);
-            bb.makeMove(moves[index]);
-            threads[index] = std::async(std::launch::async, [this, depth, alpha, beta, &childLine, bb](){
-                int eval = -negaMaxConcurrent(depth-1, -beta, -alpha, childLine, bb);
-                threadsAvailable.release();
-                return eval;
-            });
-        }
-
-        int index = i++;
-        if (index >= max) break;
-        b.makeMove(moves[index]);
-        std::promise<int> val;
-        threads[index] = val.get_future();
-        val.set_value(-negaMaxConcurrent(depth-1, -beta, -alpha, childLine, b));
-        b.unMakeMove(moves[index]);
+/**
+ * Rewards the quiet move that caused a beta cutoff and penalises the quiet moves tried before it
+ *
+ * @param thread the search thread
+ * @param ply the ply of the node
+ * @param depth the depth of the node, deeper cutoffs count for more
+ * @param bestMove the move that caused the cutoff
+ * @param quietsTried the quiet moves searched before it
+ * @param quietCount the number of quiet moves searched before it
+ */
+void Bot::updateQuietHeuristics(SearchThread& thread, int ply, int depth, const Move& bestMove, const Move* quietsTried, int quietCount) {
+    const Board& b = thread.board;
+    const int colour = b.getWhiteTurn() ? PieceType::WHITE : PieceType::BLACK;
+    const int bonus = std::min(depth * depth, HISTORY_MAX / 4);
+
+    if (bestMove != thread.killers[ply][0]) {
+        thread.killers[ply][1] = thread.killers[ply][0];
+        thread.killers[ply][0] = bestMove;
     }
 
-    //this is slower because it has to wait for all child threads to complete before alpha-beta pruning, i.e.: no pruning at all
-    for (int i = 0; i < threads.size(); i++) {
-        int val = threads[i].get();
-
-        if (val >= beta) {
-            return beta;
-        }
-        if (val > alpha) {
-            alpha = val;
-            
-            parentLine.moves[0] = moves[i];
-            memcpy(parentLine.moves+1, childLine.moves, childLine.moveCount * sizeof(Move));
-            parentLine.moveCount = childLine.moveCount + 1;
-        }
+    if (ply > 0 && thread.moveStack[ply-1].pack()) {
+        const Move& previous = thread.moveStack[ply-1];
+        thread.counterMoves[b.getType(previous.getEndPos())][previous.getEndPos()] = bestMove;
     }
 
-    return alpha;
+    updateHistory(thread.history[colour][bestMove.getStartPos()][bestMove.getEndPos()], bonus, HISTORY_MAX);
+    for (int i = 0; i < quietCount; i++)
+        updateHistory(thread.history[colour][quietsTried[i].getStartPos()][quietsTried[i].getEndPos()], -bonus, HISTORY_MAX);
 }
 
-int Bot::quiescence(int alpha, int beta, Board& b) {
-    int staticEval = Eval::pestoEval(b);
-
-    int bestValue = staticEval;
-    if (bestValue >= beta)
-        return bestValue;
-    if  (bestValue > alpha)
-        alpha = bestValue;
+//prints the uci info line of a completed iteration
+void Bot::printInfo(const SearchThread& thread) {
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - searchStart);
+
+    //every thread adds to the nodes of the search, not just the main thread
+    uint64_t nodes = 0;
+    for (const SearchThread& searchThread : searchThreads)
+        nodes += searchThread.nodes.load(std::memory_order_relaxed);
+
+    //mates are reported in moves, negative when being mated
+    std::cout << "info depth " << thread.completedDepth << " seldepth " << thread.selDepth;
+    if (Eval::isMateScore(thread.score))
+        std::cout << " score mate " << (thread.score > 0 ? (Eval::CHEKMATE_ABSOLUTE_SCORE - thread.score + 1) / 2
+                                                         : -(Eval::CHEKMATE_ABSOLUTE_SCORE + thread.score) / 2);
+    else
+        std::cout << " score cp " << thread.score;
+    std::cout << " nodes " << nodes << " nps " << nodes * 1000 / std::max<int64_t>(elapsed.count(), 1)
+              << " time " << elapsed.count() << " pv";
+    for (int i = 0; i < thread.pv.moveCount; i++)
+        std::cout << ' ' << thread.pv.moves[i].toString();
+    std::cout << std::endl;
+
+    std::cout << "info string qnodes " << thread.qNodes << " qdepth " << thread.maxQDepth << std::endl;
+}
 
-    std::vector<Move> moves = MoveGeneration::generateMoves(b);
-    if (moves.size()) orderMovesQuiescence(moves);
+//whether the side to move has anything other than pawns and its king
+static bool hasNonPawnMaterial(const Board& board) {
+    const std::array<uint64_t, 14>& bitBoards = board.getBitBoards();
+    const int colour = board.getWhiteTurn() ? PieceType::WHITE : PieceType::BLACK;
 
-    for (const Move& move : moves) {
-        b.makeMove(move);
+    return bitBoards[PieceType::WHITE_PIECES + colour] & ~(bitBoards[PieceType::WHITE_PAWN + colour] | bitBoards[PieceType::WHITE_KING + colour]);
+}
 
-        int eval = -quiescence(-beta, -alpha, b);
+bool Bot::checkTimer() {
+    if (std::chrono::high_resolution_clock::now() <= searchDeadline)
+        return false;
 
-        b.unMakeMove(move);
+    searchStopped.store(true);
+    return true;
+}
 
-        if (eval >= beta)
-            return eval;
-        if (eval > bestValue)
-            bestValue = eval;
-        if (eval > alpha)
-            alpha = eval;
-    }
+//counts a node of either search towards the next clock check, which only the main thread makes
+bool Bot::pollTimer(SearchThread& thread) {
+    if (thread.id != 0 || ++thread.timerPoll < SEARCH_TIMER_NODE_FREQUENCY)
+        return false;
 
-    return bestValue;
+    thread.timerPoll = 0;
+    return checkTimer();
 }
 
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// * ----------------------------------------- [ HELPER METHODS ] ---------------------------------------- * //
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//history gravity, the closer an entry is to the limit the less a bonus in the same direction moves it
+static void updateHistory(int& entry, int bonus, int max) {
+    entry += bonus - entry * std::abs(bonus) / max;
+}
 
-void Bot::orderMoves(std::vector<Move>& moves) {
-    for (Move& m : moves) {
-        for (int i = 0; i < principalVariation.moveCount; i++) {
-            if (m == principalVariation.moves[i]) {
-                m.heuristic *= 10;
-                break;
-            }
-        }
-    }
+//mate scores are stored relative to the node instead of the root, so they stay correct wherever the position is
+//found again
+static int scoreToTT(int score, int ply) {
+    if (score > Eval::MATE_BOUND)   return score + ply;
+    if (score < -Eval::MATE_BOUND)  return score - ply;
+    return score;
+}
 
-    std::sort(moves.begin(), moves.end(), [](const Move& a, const Move& b){
-        return a.heuristic > b.heuristic;
-    });
+static int scoreFromTT(int score, int ply) {
+    if (score > Eval::MATE_BOUND)   return score - ply;
+    if (score < -Eval::MATE_BOUND)  return score + ply;
+    return score;
 }
 
-void Bot::orderMovesQuiescence(std::vector<Move>& moves) {
-    moves.erase(std::remove_if(moves.begin(), moves.end(), [](const Move& m) {
-        return m.heuristic <= 3;
-    }), moves.end());
+//the material a capture or promotion wins if it isn't recaptured
+static int captureGain(const Board& board, const Move& move) {
+    const PieceType::Enum victim = move.getFlag() == MoveType::EN_PASSANT ? PieceType::WHITE_PAWN : board.getType(move.getEndPos());
 
-    std::sort(moves.begin(), moves.end(), [](const Move& a, const Move& b){
-        return a.heuristic > b.heuristic;
-    });
-}
+    int gain = victim == PieceType::INVALID ? 0 : SEE::PIECE_VALUES[victim / 2];
+    if (move.getFlag() == MoveType::PROMOTION)
+        gain += SEE::PIECE_VALUES[move.getPromotionPiece() + 1] - SEE::PIECE_VALUES[0];
 
-bool Bot::checkTimer() {
-    return (searchDeadlineReached = std::chrono::high_resolution_clock::now() > searchDeadline);
+    return gain;
 }
@@ -11,6 +11,7 @@
 
 //must be different to whatever you pass into negamax as alpha/beta
 const int Eval::CHEKMATE_ABSOLUTE_SCORE = INT_MAX/10;
+const int Eval::MATE_BOUND = CHEKMATE_ABSOLUTE_SCORE - 1000; //further than any line can reach
 
 const static int PAWN = 0;
 const static int KING = 5;
@@ -221,11 +222,15 @@ int Eval::pestoEval(const Board& boardRef) {
     return (mgScore * mgPhase + egScore * egPhase) / 24;
 }
 
-int Eval::terminalNodeEval(const Board& boardRef) {
+int Eval::terminalNodeEval(const Board& boardRef, int ply) {
     if (MoveGeneration::isKingTargeted(boardRef)) {
-        //checkmate
-        return -CHEKMATE_ABSOLUTE_SCORE;
+        //checkmate, the further from the root the better for the side being mated
+        return -CHEKMATE_ABSOLUTE_SCORE + ply;
     }
     //stalemate
     return 0;
 }
+
+bool Eval::isMateScore(int score) {
+    return score > MATE_BOUND || score < -MATE_BOUND;
+}
@@ -0,0 +1,231 @@
+#include "bot/MovePicker.hpp"
+
+#include <cstdint>
+
+#include "board/Board.hpp"
+#include "board/Move.hpp"
+#include "board/MoveList.hpp"
+#include "bot/See.hpp"
+#include "moveGeneration/MoveGenerator.hpp"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// * ----------------------------------------- [ STATIC MEMBERS ] ---------------------------------------- * //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//tactical evasions are tried before every quiet evasion, whatever its history
+static const int EVASION_CAPTURE_SCORE = 1 << 20;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// * ------------------------------------ [ CONSTRUCTORS/DESCTUCTOR ] ------------------------------------ * //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Creates a picker for a node of the main search, yielding every legal move
+ *
+ * @param board the board, must not change while the picker is in use
+ * @param hashMove the packed move from the transposition table, 0 if there isn't one
+ * @param killers the killers of the ply of the node
+ * @param counterMove the countermove of the previous move, a null Move if there isn't one
+ * @param history the history of the side to move
+ * @param inCheck whether the side to move is in check
+ */
+MovePicker::MovePicker(const Board& board, uint16_t hashMove, const Move (&killers)[2], const Move& counterMove, const int (&history)[64][64], bool inCheck) :
+    board(board), history(history), stage(HASH_MOVE), inCheck(inCheck), skipBadCaptures(false), includeQuietChecks(false), hashMove(hashMove),
+    refutations{killers[0], killers[1], counterMove}
+{
+    if (counterMove == killers[0] || counterMove == killers[1])
+        refutations[2] = Move();
+}
+
+/**
+ * Creates a picker for a node of quiescence search, yielding the captures that don't lose material then optionally
+ * the quiet checks, or every legal move when in check
+ *
+ * @param board the board, must not change while the picker is in use
+ * @param history the history of the side to move, used to order quiet evasions and checks
+ * @param inCheck whether the side to move is in check
+ * @param includeQuietChecks whether to yield the quiet moves that give check after the captures
+ */
+MovePicker::MovePicker(const Board& board, const int (&history)[64][64], bool inCheck, bool includeQuietChecks) :
+    board(board), history(history), stage(inCheck ? GENERATE_EVASIONS : GENERATE_CAPTURES), inCheck(inCheck), skipBadCaptures(true),
+    includeQuietChecks(includeQuietChecks)
+{}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// * ----------------------------------------- [ PUBLIC METHODS ] ---------------------------------------- * //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Picks the next move to search, generating the next stage if the current one has run out
+ *
+ * @return the move, or a null Move once every move has been picked
+ */
+Move MovePicker::next() {
+    for (;;) {
+        switch (stage) {
+            case HASH_MOVE:
+                stage = inCheck ? GENERATE_EVASIONS : GENERATE_CAPTURES;
+                if (hashMove.pack() && MoveGeneration::isLegal(board, hashMove))
+                    return hashMove;
+                hashMove = Move();
+                break;
+
+            case GENERATE_CAPTURES:
+                moves.clear();
+                MoveGeneration::generateCaptures(board, moves);
+                scoreCaptures();
+                index = 0;
+                stage = GOOD_CAPTURES;
+                break;
+
+            //captures losing material are put aside until after the quiet moves, or dropped in quiescence
+            case GOOD_CAPTURES:
+                while (index < moves.size()) {
+                    moves.selectBest(index);
+                    const Move move = moves[index++];
+
+                    if (move == hashMove)
+                        continue;
+                    if (SEE::evaluate(board, move) >= 0)
+                        return move;
+                    if (!skipBadCaptures)
+                        badCaptures.push_back(move);
+                }
+                stage = !skipBadCaptures ? REFUTATIONS : includeQuietChecks ? GENERATE_QUIETS : DONE;
+                break;
+
+            //refutations come from other nodes so they have to be checked, and are left to the captures if they capture here
+            case REFUTATIONS:
+                while (refutationIndex < 3) {
+                    Move& move = refutations[refutationIndex++];
+
+                    if (move.pack() && move != hashMove && !isTactical(board, move) && MoveGeneration::isLegal(board, move))
+                        return move;
+                    move = Move(); //not yielded, so the quiets stage mustn't skip it
+                }
+                stage = GENERATE_QUIETS;
+                break;
+
+            case GENERATE_QUIETS:
+                moves.clear();
+                MoveGeneration::generateQuiets(board, moves);
+                if (includeQuietChecks)
+                    keepChecks();
+                scoreQuiets();
+                index = 0;
+                stage = includeQuietChecks ? QUIET_CHECKS : QUIETS;
+                break;
+
+            case QUIETS:
+                while (index < moves.size()) {
+                    moves.selectBest(index);
+                    const Move move = moves[index++];
+
+                    if (move != hashMove && !isRefutation(move))
+                        return move;
+                }
+                index = 0;
+                stage = BAD_CAPTURES;
+                break;
+
+            case BAD_CAPTURES:
+                if (index < badCaptures.size())
+                    return badCaptures[index++];
+                stage = DONE;
+                break;
+
+            case QUIET_CHECKS:
+                if (index < moves.size()) {
+                    moves.selectBest(index);
+                    return moves[index++];
+                }
+                stage = DONE;
+                break;
+
+            case GENERATE_EVASIONS:
+                moves.clear();
+                MoveGeneration::generateEvasions(board, moves);
+                scoreEvasions();
+                index = 0;
+                stage = EVASIONS;
+                break;
+
+            case EVASIONS:
+                while (index < moves.size()) {
+                    moves.selectBest(index);
+                    const Move move = moves[index++];
+
+                    if (move != hashMove)
+                        return move;
+                }
+                stage = DONE;
+                break;
+
+            case DONE:
+                return Move();
+        }
+    }
+}
+
+/**
+ * Most valuable victim, least valuable attacker ordering score of a capture or promotion, from 0 to 79
+ *
+ * Captures are ordered by the value of the captured piece first then by the cheapness of the capturing piece,
+ * promotions count the promoted piece as a second victim
+ *
+ * @param board the board the move is played on
+ * @param move the move
+ * @return the score, higher is tried first
+ */
+int MovePicker::mvvLva(const Board& board, const Move& move) {
+    const PieceType::Enum victim = move.getFlag() == MoveType::EN_PASSANT ? PieceType::WHITE_PAWN : board.getType(move.getEndPos());
+    const int attacker = board.getType(move.getStartPos()) / 2;
+
+    int score = victim == PieceType::INVALID ? 0 : 8 * (victim / 2 + 1) - attacker;
+    if (move.getFlag() == MoveType::PROMOTION)
+        score += 8 * (move.getPromotionPiece() + 2);
+
+    return score;
+}
+
+//captures, en passant and promotions
+bool MovePicker::isTactical(const Board& board, const Move& move) {
+    return board.getType(move.getEndPos()) != PieceType::INVALID || move.getFlag() == MoveType::PROMOTION || move.getFlag() == MoveType::EN_PASSANT;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// * ----------------------------------------- [ HELPER METHODS ] ---------------------------------------- * //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void MovePicker::scoreCaptures() {
+    for (int i = 0; i < moves.size(); i++)
+        moves.getScore(i) = mvvLva(board, moves[i]);
+}
+
+void MovePicker::scoreQuiets() {
+    for (int i = 0; i < moves.size(); i++)
+        moves.getScore(i) = history[moves[i].getStartPos()][moves[i].getEndPos()];
+}
+
+void MovePicker::scoreEvasions() {
+    for (int i = 0; i < moves.size(); i++) {
+        const Move& move = moves[i];
+
+        moves.getScore(i) = isTactical(board, move) ? EVASION_CAPTURE_SCORE + mvvLva(board, move)
+                                                    : history[move.getStartPos()][move.getEndPos()];
+    }
+}
+
+//drops every move that doesn't give check from the current stage
+void MovePicker::keepChecks() {
+    int count = 0;
+    for (int i = 0; i < moves.size(); i++)
+        if (MoveGeneration::givesCheck(board, moves[i]))
+            moves[count++] = moves[i];
+
+    moves.resize(count);
+}
+
+bool MovePicker::isRefutation(const Move& move) const {
+    return move == refutations[0] || move == refutations[1] || move == refutations[2];
+}
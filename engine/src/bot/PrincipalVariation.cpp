@@ -7,3 +7,10 @@ void pVariation::print() const {
         std::cout << moves[i].toString() << '\n';
     }
 }
+
+//copies the line from the root into a pv
+void PvTable::copyRoot(pVariation& line) const {
+    line.moveCount = ends[0];
+    for (int i = 0; i < line.moveCount; i++)
+        line.moves[i] = moves[0][i];
+}
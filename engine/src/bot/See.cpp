@@ -0,0 +1,106 @@
+#include "bot/See.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include "board/BitboardTables.hpp"
+#include "board/Board.hpp"
+#include "board/BoardUtil.hpp"
+#include "board/Move.hpp"
+#include "moveGeneration/MagicBitboards.hpp"
+
+using BitboardTables::tables;
+
+//indexed by PieceType::Enum / 2, the king is worth more than everything else combined
+const int SEE::PIECE_VALUES[6] = { 100, 320, 330, 500, 900, 20000 };
+
+static const int PAWN = 0;
+static const int KING = 5;
+
+/**
+ * Plays out every capture on the target square of a move, each side recapturing with its least valuable attacker
+ * and able to stop whenever recapturing would lose material
+ *
+ * Sliders behind a piece that has captured are added to the attackers as it leaves, the king only recaptures if
+ * the other side has no attackers left
+ *
+ * @param board the board
+ * @param move the move, usually a capture. Castles are always 0
+ * @return the material gained by the side making the move, in centipawns
+ */
+int SEE::evaluate(const Board& board, const Move& move) {
+    if (move.getFlag() == MoveType::CASTLE)
+        return 0;
+
+    const std::array<uint64_t, 14>&     bitBoards       = board.getBitBoards();
+    const SquareIndex                   startPos        = move.getStartPos();
+    const SquareIndex                   endPos          = move.getEndPos();
+    const int                           moverColour     = PIECE_COLOUR(board.getType(startPos));
+
+    const uint64_t rooks    = bitBoards[PieceType::WHITE_ROOK] | bitBoards[PieceType::BLACK_ROOK] | bitBoards[PieceType::WHITE_QUEEN] | bitBoards[PieceType::BLACK_QUEEN];
+    const uint64_t bishops  = bitBoards[PieceType::WHITE_BISHOP] | bitBoards[PieceType::BLACK_BISHOP] | bitBoards[PieceType::WHITE_QUEEN] | bitBoards[PieceType::BLACK_QUEEN];
+
+    uint64_t occupied = bitBoards[PieceType::WHITE_PIECES] | bitBoards[PieceType::BLACK_PIECES];
+    int gain[32];
+    int pieceValue = PIECE_VALUES[board.getType(startPos) / 2];    //value of the piece that would be taken next
+    int depth = 0;
+
+    if (move.getFlag() == MoveType::EN_PASSANT) {
+        gain[0] = PIECE_VALUES[PAWN];
+        occupied ^= 1ULL << ((endPos & ~7) | (startPos & 7));
+    }
+    else {
+        PieceType::Enum captured = board.getType(endPos);
+        gain[0] = captured == PieceType::INVALID ? 0 : PIECE_VALUES[captured / 2];
+    }
+
+    if (move.getFlag() == MoveType::PROMOTION) {
+        pieceValue = PIECE_VALUES[move.getPromotionPieceType(moverColour) / 2];
+        gain[0] += pieceValue - PIECE_VALUES[PAWN];
+    }
+
+    uint64_t attackers = (tables.knight[endPos] & (bitBoards[PieceType::WHITE_KNIGHT] | bitBoards[PieceType::BLACK_KNIGHT]))
+                       | (tables.king[endPos] & (bitBoards[PieceType::WHITE_KING] | bitBoards[PieceType::BLACK_KING]))
+                       | (tables.pawnAttacks[PieceType::BLACK][endPos] & bitBoards[PieceType::WHITE_PAWN])
+                       | (tables.pawnAttacks[PieceType::WHITE][endPos] & bitBoards[PieceType::BLACK_PAWN])
+                       | (rookAttacks(endPos, occupied) & rooks)
+                       | (bishopAttacks(endPos, occupied) & bishops);
+
+    uint64_t from = 1ULL << startPos;
+    int side = moverColour;
+
+    for (;;) {
+        depth++;
+        gain[depth] = pieceValue - gain[depth-1];
+
+        //neither side can do better by carrying on
+        if (std::max(-gain[depth-1], gain[depth]) < 0)
+            break;
+
+        //the piece that captured leaves its square, uncovering any slider behind it
+        occupied ^= from;
+        attackers = (attackers | (rookAttacks(endPos, occupied) & rooks) | (bishopAttacks(endPos, occupied) & bishops)) & occupied;
+        side ^= 1;
+
+        const uint64_t sideAttackers = attackers & bitBoards[PieceType::WHITE_PIECES + side];
+        if (!sideAttackers)
+            break;
+
+        int type = PAWN;
+        while (!(sideAttackers & bitBoards[2*type + side]))
+            type++;
+
+        if (type == KING && (attackers & bitBoards[PieceType::WHITE_PIECES + (side ^ 1)]))
+            break;
+
+        from = sideAttackers & bitBoards[2*type + side];
+        from &= -from;
+        pieceValue = PIECE_VALUES[type];
+    }
+
+    while (--depth)
+        gain[depth-1] = -std::max(-gain[depth-1], gain[depth]);
+
+    return gain[0];
+}
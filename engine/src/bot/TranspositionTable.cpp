@@ -0,0 +1,138 @@
+#include "bot/TranspositionTable.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+//layout of the data word of a slot
+#define DATA_MOVE(d)    ((uint16_t)((d) & 0xFFFF))
+#define DATA_SCORE(d)   ((int)(int32_t)(uint32_t)((d) >> 16))
+#define DATA_DEPTH(d)   ((int)(((d) >> 48) & 0xFF))
+#define DATA_BOUND(d)   ((Bound)(((d) >> 56) & 0x3))
+#define DATA_AGE(d)     ((uint8_t)((d) >> 58))
+
+#define AGE_MASK 0x3F
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// * ------------------------------------ [ CONSTRUCTORS/DESCTUCTOR ] ------------------------------------ * //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TranspositionTable::TranspositionTable(size_t sizeMb) {
+    resize(sizeMb);
+}
+
+TranspositionTable::~TranspositionTable() {
+    delete[] buckets;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// * ----------------------------------------- [ PUBLIC METHODS ] ---------------------------------------- * //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Reallocates the table to the given size, clearing all entries. Must not be called during a search
+ *
+ * @param sizeMb the size of the table in megabytes
+ */
+void TranspositionTable::resize(size_t sizeMb) {
+    delete[] buckets;
+
+    bucketCount = (sizeMb * 1024 * 1024) / sizeof(Bucket);
+    if (bucketCount == 0) bucketCount = 1;
+
+    buckets = new Bucket[bucketCount];
+    age = 0;
+}
+
+/**
+ * Clears all entries in the table. Must not be called during a search
+ */
+void TranspositionTable::clear() {
+    for (size_t i = 0; i < bucketCount; i++) {
+        for (Slot& slot : buckets[i].slots) {
+            slot.key.store(0, std::memory_order_relaxed);
+            slot.data.store(0, std::memory_order_relaxed);
+        }
+    }
+    age = 0;
+}
+
+/**
+ * Marks the start of a new search, so that entries from older searches are replaced first
+ */
+void TranspositionTable::newSearch() {
+    age = (age + 1) & AGE_MASK;
+}
+
+/**
+ * Looks up the entry for a given position
+ *
+ * @param hash the zobrist hash of the position
+ * @param entry the entry reference to return the entry to
+ * @return whether or not an entry was found
+ */
+bool TranspositionTable::probe(uint64_t hash, TTEntry& entry) const {
+    for (const Slot& slot : getBucket(hash).slots) {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        uint64_t key  = slot.key.load(std::memory_order_relaxed);
+
+        if ((key ^ data) != hash || data == 0)
+            continue;
+
+        entry = {DATA_SCORE(data), DATA_DEPTH(data), DATA_BOUND(data), DATA_MOVE(data)};
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * Stores the result of a search. Replaces the entry for the same position if there is one, otherwise
+ * the entry with the lowest depth, with entries from older searches counting as shallower
+ *
+ * @param hash the zobrist hash of the position
+ * @param depth the depth that was searched
+ * @param score the score found
+ * @param bound whether the score is exact, a lower bound, or an upper bound
+ * @param move the packed best move, or 0 if there isn't one
+ */
+void TranspositionTable::store(uint64_t hash, int depth, int score, Bound bound, uint16_t move) {
+    Bucket& bucket = getBucket(hash);
+    Slot* replace = &bucket.slots[0];
+    int replaceValue = INT32_MAX;
+
+    for (Slot& slot : bucket.slots) {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        uint64_t key  = slot.key.load(std::memory_order_relaxed);
+
+        //same position, keep the old best move if we don't have a new one
+        if ((key ^ data) == hash) {
+            if (!move) move = DATA_MOVE(data);
+            replace = &slot;
+            break;
+        }
+
+        int value = DATA_DEPTH(data) - 8 * ((age - DATA_AGE(data)) & AGE_MASK);
+        if (value < replaceValue) {
+            replaceValue = value;
+            replace = &slot;
+        }
+    }
+
+    uint64_t data = (uint64_t)move
+                  | ((uint64_t)(uint32_t)score << 16)
+                  | ((uint64_t)(depth & 0xFF) << 48)
+                  | ((uint64_t)bound << 56)
+                  | ((uint64_t)age << 58);
+
+    replace->key.store(hash ^ data, std::memory_order_relaxed);
+    replace->data.store(data, std::memory_order_relaxed);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// * ----------------------------------------- [ HELPER METHODS ] ---------------------------------------- * //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//maps the hash onto a bucket using the high bits of hash * bucketCount, avoiding a modulo
+TranspositionTable::Bucket& TranspositionTable::getBucket(uint64_t hash) const {
+    return buckets[(uint64_t)(((__uint128_t)hash * bucketCount) >> 64)];
+}
@@ -1,66 +1,57 @@
 #include "moveGeneration/MoveGenerator.hpp"
 
-#include <vector>
+#include <algorithm>
+#include <cassert>
 #include <cstdint>
 
 #include "board/Move.hpp"
+#include "board/MoveList.hpp"
 #include "board/Board.hpp"
 #include "board/BoardUtil.hpp"
+#include "board/BitboardTables.hpp"
+#include "moveGeneration/MagicBitboards.hpp"
 #include "moveGeneration/MoveGeneratorInternals.hpp"
 
+static void generate(const Board& board, MoveList& moves, MoveGeneration::GenType genType);
+
 /**
- * Generates all possible moves based on a given board and whos to move
+ * Generates all legal moves based on a given board and whos to move
  * 
  * @param board the board
- * @param whiteTurn whether or not it is whites turn to move
- * @return a vector of valid moves
+ * @param moves the move list to add the legal moves to, expected to be empty
  */
-std::vector<Move> MoveGeneration::generateMoves(Board& board) {
-    //return vector containing all moves converted into type Move.
-    std::vector<Move> moves;
-    moves.reserve(32);
+void MoveGeneration::generateMoves(const Board& board, MoveList& moves) {
+    generate(board, moves, ALL);
+}
 
-    //constant values including the bitboards and masks
-    const std::array<uint64_t, 14>&     bitBoards           = board.getBitBoards();
-    const std::array<__uint128_t, 16>&  enPassantData       = board.getEnPassantData();
-    const std::array<__uint128_t, 4>&   castleData          = board.getCastleData();
-    const WhiteTurn                     whiteTurn           = board.getWhiteTurn();
-    const uint64_t                      whitePieces         = bitBoards[PieceType::WHITE_PIECES];
-    const uint64_t                      blackPieces         = bitBoards[PieceType::BLACK_PIECES];
-    const uint64_t                      friendlyPieces      = whiteTurn ? whitePieces : blackPieces;
-    const uint64_t                      oppositionPieces    = whiteTurn ? blackPieces : whitePieces;
-    const uint64_t                      occupied            = whitePieces | blackPieces;
-    const uint64_t                      unoccupied          = ~occupied;
-    const short                         indexOffset         = whiteTurn ? 0 : PieceType::BLACK-PieceType::WHITE;
-    
-    //generate moves
-    generateEnPassantMoves(moves, board, whiteTurn, bitBoards[PieceType::WHITE_PAWN + indexOffset], enPassantData);
-    generateCastlingMoves(moves, board, whiteTurn, occupied, castleData);
-    generateKnightMoves(moves, board, whiteTurn, bitBoards[PieceType::WHITE_KNIGHT + indexOffset], friendlyPieces);
-    generatePawnMoves(moves, board, whiteTurn, bitBoards[PieceType::WHITE_PAWN + indexOffset], unoccupied, oppositionPieces);
-    generateBishopMoves(moves, board, whiteTurn, bitBoards[PieceType::WHITE_BISHOP + indexOffset], occupied, friendlyPieces);
-    generateRookMoves(moves, board, whiteTurn, bitBoards[PieceType::WHITE_ROOK + indexOffset], occupied, friendlyPieces);
-    generateQueenMoves(moves, board, whiteTurn, bitBoards[PieceType::WHITE_QUEEN + indexOffset], occupied, friendlyPieces);
-    generateKingMoves(moves, board, whiteTurn, bitBoards[PieceType::WHITE_KING + indexOffset], friendlyPieces);
-
-    //filter out moves that leave the king in check
-    std::vector<Move> retMoves;
-    retMoves.reserve(moves.size());
-
-    SquareIndex kingIndex;
-
-    for (auto& move : moves) {
-        board.makeMove(move);
-        kingIndex = (SquareIndex)__builtin_ctzll(bitBoards[PieceType::WHITE_KING + indexOffset]);
-
-        if (!isTargeted(board, !whiteTurn, kingIndex))
-            retMoves.emplace_back(move);
-
-        board.unMakeMove(move);
-    }
+/**
+ * Generates the legal captures, en passant moves and queen promotions, used by quiescence search
+ * 
+ * @param board the board
+ * @param moves the move list to add the moves to
+ */
+void MoveGeneration::generateCaptures(const Board& board, MoveList& moves) {
+    generate(board, moves, CAPTURES);
+}
 
-    //finally return
-    return retMoves;
+/**
+ * Generates the legal moves that generateCaptures() doesn't, so that together they make up every legal move
+ * 
+ * @param board the board
+ * @param moves the move list to add the moves to
+ */
+void MoveGeneration::generateQuiets(const Board& board, MoveList& moves) {
+    generate(board, moves, QUIETS);
+}
+
+/**
+ * Generates every legal move out of check, the board must be in check
+ * 
+ * @param board the board
+ * @param moves the move list to add the moves to
+ */
+void MoveGeneration::generateEvasions(const Board& board, MoveList& moves) {
+    generate(board, moves, EVASIONS);
 }
 
 /**
@@ -77,3 +68,169 @@ bool MoveGeneration::isKingTargeted(const Board& board) {
     
     return isTargeted(board, !whiteTurn, kingIndex);
 }
+
+/**
+ * Determines whether a move that didn't come from the move generator, such as a hash move or a killer, is legal
+ * in the given board, without generating every move
+ * 
+ * @param board the board
+ * @param move the move
+ * @return whether or not the move is legal
+ */
+bool MoveGeneration::isLegal(const Board& board, const Move& move) {
+    using BitboardTables::tables;
+
+    const std::array<uint64_t, 14>& bitBoards       = board.getBitBoards();
+    const WhiteTurn                 whiteTurn       = board.getWhiteTurn();
+    const int                       colour          = whiteTurn ? PieceType::WHITE : PieceType::BLACK;
+    const uint64_t                  friendlyPieces  = bitBoards[PieceType::WHITE_PIECES + colour];
+    const uint64_t                  occupied        = bitBoards[PieceType::WHITE_PIECES] | bitBoards[PieceType::BLACK_PIECES];
+    const SquareIndex               start           = move.getStartPos();
+    const SquareIndex               end             = move.getEndPos();
+    const uint64_t                  endBitboard     = 1ULL << end;
+    const PieceType::Enum           piece           = board.getType(start);
+
+    if (piece == PieceType::INVALID || PIECE_COLOUR(piece) != colour || (endBitboard & friendlyPieces))
+        return false;
+
+    //castling and en passant are rare enough to check against the generator
+    if (move.getFlag() == MoveType::CASTLE || move.getFlag() == MoveType::EN_PASSANT) {
+        MoveList moves;
+        generate(board, moves, move.getFlag() == MoveType::CASTLE ? QUIETS : CAPTURES);
+        return std::find(moves.begin(), moves.end(), move) != moves.end();
+    }
+
+    const bool isPawn       = piece == PieceType::WHITE_PAWN + colour;
+    const bool isLastRank   = (end & 7) == (whiteTurn ? 7 : 0);
+    if ((move.getFlag() == MoveType::PROMOTION) != (isPawn && isLastRank))
+        return false;
+
+    const SquareIndex   kingIndex   = (SquareIndex)__builtin_ctzll(bitBoards[PieceType::WHITE_KING + colour]);
+    const LegalityMasks masks       = generateLegalityMasks(board, whiteTurn, kingIndex);
+
+    if (start == kingIndex)
+        return (tables.king[start] & endBitboard) && !(masks.targeted & endBitboard);
+
+    //in double check only the king can move, otherwise the move has to resolve the check and stay on its pin
+    if (masks.checkers & (masks.checkers - 1))
+        return false;
+    if (!(masks.checkMask & endBitboard))
+        return false;
+    if (((masks.orthogonalPins | masks.diagonalPins) & (1ULL << start)) && !(tables.line[kingIndex][start] & endBitboard))
+        return false;
+
+    if (isPawn) {
+        const int forward = whiteTurn ? 1 : -1;
+
+        if (tables.pawnAttacks[colour][start] & endBitboard)
+            return endBitboard & occupied;
+        if (end == start + forward)
+            return !(endBitboard & occupied);
+        return end == start + 2*forward && (start & 7) == (whiteTurn ? 1 : 6)
+            && !(((1ULL << (start + forward)) | endBitboard) & occupied);
+    }
+
+    switch (piece - colour) {
+        case PieceType::WHITE_KNIGHT:   return tables.knight[start] & endBitboard;
+        case PieceType::WHITE_BISHOP:   return bishopAttacks(start, occupied) & endBitboard;
+        case PieceType::WHITE_ROOK:     return rookAttacks(start, occupied) & endBitboard;
+        case PieceType::WHITE_QUEEN:    return queenAttacks(start, occupied) & endBitboard;
+        default:                        return false;
+    }
+}
+
+/**
+ * Determines whether a legal move gives check, directly or by uncovering a slider, without making it
+ * 
+ * @param board the board
+ * @param move the move, must be legal
+ * @return whether or not the move checks the opposition king
+ */
+bool MoveGeneration::givesCheck(const Board& board, const Move& move) {
+    using BitboardTables::tables;
+
+    //castling and en passant move a second piece, they are rare enough to just make
+    if (move.getFlag() == MoveType::CASTLE || move.getFlag() == MoveType::EN_PASSANT) {
+        Board copy(board);
+        copy.makeMove(move);
+        return isKingTargeted(copy);
+    }
+
+    const std::array<uint64_t, 14>& bitBoards       = board.getBitBoards();
+    const int                       colour          = board.getWhiteTurn() ? PieceType::WHITE : PieceType::BLACK;
+    const SquareIndex               start           = move.getStartPos();
+    const SquareIndex               end             = move.getEndPos();
+    const SquareIndex               kingIndex       = (SquareIndex)__builtin_ctzll(bitBoards[PieceType::BLACK_KING - colour]);
+    const uint64_t                  kingBitboard    = 1ULL << kingIndex;
+    const uint64_t                  occupied        = ((bitBoards[PieceType::WHITE_PIECES] | bitBoards[PieceType::BLACK_PIECES]) & ~(1ULL << start)) | (1ULL << end);
+    const int                       piece           = move.getFlag() == MoveType::PROMOTION ? move.getPromotionPieceType(colour) : board.getType(start);
+
+    //direct check by the piece on its end square
+    switch (piece - colour) {
+        case PieceType::WHITE_PAWN:     if (tables.pawnAttacks[colour][end] & kingBitboard) return true; break;
+        case PieceType::WHITE_KNIGHT:   if (tables.knight[end] & kingBitboard) return true; break;
+        case PieceType::WHITE_BISHOP:   if (bishopAttacks(end, occupied) & kingBitboard) return true; break;
+        case PieceType::WHITE_ROOK:     if (rookAttacks(end, occupied) & kingBitboard) return true; break;
+        case PieceType::WHITE_QUEEN:    if (queenAttacks(end, occupied) & kingBitboard) return true; break;
+        default:                        break;
+    }
+
+    //discovered check by a slider the piece was blocking
+    const uint64_t queens       = bitBoards[PieceType::WHITE_QUEEN + colour];
+    const uint64_t orthogonal   = (bitBoards[PieceType::WHITE_ROOK + colour] | queens) & ~(1ULL << start);
+    const uint64_t diagonal     = (bitBoards[PieceType::WHITE_BISHOP + colour] | queens) & ~(1ULL << start);
+
+    return (rookAttacks(kingIndex, occupied) & orthogonal) || (bishopAttacks(kingIndex, occupied) & diagonal);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// * ----------------------------------------- [ STATIC METHODS ] ---------------------------------------- * //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//generates the legal moves of the given type, every piece but the pawns is restricted by its target squares alone
+static void generate(const Board& board, MoveList& moves, MoveGeneration::GenType genType) {
+
+    //constant values including the bitboards and masks
+    const std::array<uint64_t, 14>&     bitBoards           = board.getBitBoards();
+    const SquareIndex                   enPassantSquare     = board.getEnPassantSquare();
+    const uint8_t                       castlingRights      = board.getCastlingRights();
+    const WhiteTurn                     whiteTurn           = board.getWhiteTurn();
+    const uint64_t                      whitePieces         = bitBoards[PieceType::WHITE_PIECES];
+    const uint64_t                      blackPieces         = bitBoards[PieceType::BLACK_PIECES];
+    const uint64_t                      friendlyPieces      = whiteTurn ? whitePieces : blackPieces;
+    const uint64_t                      oppositionPieces    = whiteTurn ? blackPieces : whitePieces;
+    const uint64_t                      occupied            = whitePieces | blackPieces;
+    const uint64_t                      unoccupied          = ~occupied;
+    const short                         indexOffset         = whiteTurn ? 0 : PieceType::BLACK-PieceType::WHITE;
+    
+    const uint64_t                      king                = bitBoards[PieceType::WHITE_KING + indexOffset];
+    const LegalityMasks                 masks               = generateLegalityMasks(board, whiteTurn, (SquareIndex)__builtin_ctzll(king));
+
+    assert(genType != MoveGeneration::EVASIONS || masks.checkers);
+
+    //the squares each type of move can land on, the king can't land anywhere else either
+    uint64_t targets = ~friendlyPieces;
+    if      (genType == MoveGeneration::CAPTURES)   targets = oppositionPieces;
+    else if (genType == MoveGeneration::QUIETS)     targets = unoccupied;
+
+    //in double check only the king can move
+    if (masks.checkers & (masks.checkers - 1)) {
+        generateKingMoves(moves, king, ~targets, masks);
+        return;
+    }
+
+    LegalityMasks pieceMasks = masks;
+    pieceMasks.checkMask &= targets;
+
+    //generate moves, every generator only produces moves that are legal under the pin and check masks
+    if (genType != MoveGeneration::QUIETS)
+        generateEnPassantMoves(moves, board, whiteTurn, bitBoards[PieceType::WHITE_PAWN + indexOffset], enPassantSquare, masks);
+    if (genType == MoveGeneration::ALL || genType == MoveGeneration::QUIETS)
+        generateCastlingMoves(moves, whiteTurn, occupied, castlingRights, masks);
+    generateKnightMoves(moves, bitBoards[PieceType::WHITE_KNIGHT + indexOffset], friendlyPieces, pieceMasks);
+    generatePawnMoves(moves, whiteTurn, bitBoards[PieceType::WHITE_PAWN + indexOffset], unoccupied, oppositionPieces, masks, genType);
+    generateBishopMoves(moves, bitBoards[PieceType::WHITE_BISHOP + indexOffset], occupied, friendlyPieces, pieceMasks);
+    generateRookMoves(moves, bitBoards[PieceType::WHITE_ROOK + indexOffset], occupied, friendlyPieces, pieceMasks);
+    generateQueenMoves(moves, bitBoards[PieceType::WHITE_QUEEN + indexOffset], occupied, friendlyPieces, pieceMasks);
+    generateKingMoves(moves, king, ~targets, masks);
+}
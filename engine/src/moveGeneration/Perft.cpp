@@ -0,0 +1,290 @@
+#include "moveGeneration/Perft.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <future>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "board/Board.hpp"
+#include "board/Move.hpp"
+#include "board/MoveList.hpp"
+#include "moveGeneration/MoveGenerator.hpp"
+#include "util/ThreadPool.hpp"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// * ----------------------------------------- [ STATIC MEMBERS ] ---------------------------------------- * //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//layout of the data word of a hash table slot
+#define DATA_NODES(d)   ((d) & 0x00FFFFFFFFFFFFFFULL)
+#define DATA_DEPTH(d)   ((int)((d) >> 56))
+
+//a subtree to count, found by playing the moves of its path from the root
+struct PerftJob {
+    std::vector<Move> path;
+};
+
+static void collectJobs(Board& board, size_t splitDepth, std::vector<Move>& path, std::vector<PerftJob>& jobs);
+static void runJobs(const Board& root, int depth, const Perft::Options& options, const std::vector<PerftJob>& jobs, std::atomic<size_t>& nextJob, Perft::ThreadStats& stats);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// * ------------------------------------ [ CONSTRUCTORS/DESCTUCTOR ] ------------------------------------ * //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Perft::HashTable::HashTable(size_t sizeMb) {
+    slotCount = std::max<size_t>((sizeMb * 1024 * 1024) / sizeof(Slot), 1);
+    slots = new Slot[slotCount];
+}
+
+Perft::HashTable::~HashTable() {
+    delete[] slots;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// * ----------------------------------------- [ PUBLIC METHODS ] ---------------------------------------- * //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// * ------------------------------------------- [ HASH TABLE ] ------------------------------------------ * //
+
+/**
+ * Looks up the node count of a given position and depth
+ *
+ * @param hash the zobrist hash of the position
+ * @param depth the depth of the subtree
+ * @param nodes the reference to return the node count to
+ * @return whether or not the count was found
+ */
+bool Perft::HashTable::probe(uint64_t hash, int depth, uint64_t& nodes) const {
+    const Slot& slot = slots[(uint64_t)(((__uint128_t)hash * slotCount) >> 64)];
+
+    uint64_t data = slot.data.load(std::memory_order_relaxed);
+    uint64_t key  = slot.key.load(std::memory_order_relaxed);
+
+    if ((key ^ data) != hash || DATA_DEPTH(data) != depth)
+        return false;
+
+    nodes = DATA_NODES(data);
+    return true;
+}
+
+/**
+ * Stores the node count of a given position and depth, always replacing the previous entry
+ *
+ * @param hash the zobrist hash of the position
+ * @param depth the depth of the subtree
+ * @param nodes the node count
+ */
+void Perft::HashTable::store(uint64_t hash, int depth, uint64_t nodes) {
+    Slot& slot = slots[(uint64_t)(((__uint128_t)hash * slotCount) >> 64)];
+    uint64_t data = DATA_NODES(nodes) | ((uint64_t)depth << 56);
+
+    slot.key.store(hash ^ data, std::memory_order_relaxed);
+    slot.data.store(data, std::memory_order_relaxed);
+}
+
+// * --------------------------------------------- [ PERFT ] --------------------------------------------- * //
+
+/**
+ * Runs perft to a given depth on a given board
+ *
+ * @param board the board, left unchanged
+ * @param depth the depth to run to
+ * @return the number of leaf nodes at the given depth
+ */
+uint64_t Perft::perft(Board& board, int depth) {
+    MoveList moves;
+    uint64_t nodes = 0;
+
+    if (depth == 0)
+        return 1ULL;
+
+    MoveGeneration::generateMoves(board, moves);
+
+    for (const Move& move : moves) {
+        board.makeMove(move);
+        nodes += perft(board, depth-1);
+        board.unMakeMove(move);
+    }
+
+    return nodes;
+}
+
+/**
+ * Runs perft to a given depth on a given board, optionally bulk counting the last depth and caching subtree counts
+ *
+ * @param board the board, left unchanged
+ * @param depth the depth to run to
+ * @param options whether to bulk count, and the hash table to use if any
+ * @return the number of leaf nodes at the given depth
+ */
+uint64_t Perft::perft(Board& board, int depth, const Options& options) {
+    if (depth == 0)
+        return 1ULL;
+
+    //counts at depth 1 are cheaper to find than to look up
+    uint64_t nodes = 0;
+    const uint64_t hash = board.getHash();
+    const bool useTable = options.table && depth > 1;
+
+    if (useTable && options.table->probe(hash, depth, nodes))
+        return nodes;
+
+    MoveList moves;
+    MoveGeneration::generateMoves(board, moves);
+
+    //every legal move is a leaf
+    if (depth == 1 && options.bulkCounting)
+        return moves.size();
+
+    for (const Move& move : moves) {
+        board.makeMove(move);
+        nodes += perft(board, depth-1, options);
+        board.unMakeMove(move);
+    }
+
+    if (useTable)
+        options.table->store(hash, depth, nodes);
+
+    return nodes;
+}
+
+/**
+ * Runs perft to a given depth on a given board across multiple threads of a thread pool
+ *
+ * The tree is split into one job per node at the split depth, each thread works on its own copy of the board
+ * and takes the next unclaimed job until there are none left
+ *
+ * @param threadPool the pool to run the threads on
+ * @param board the board
+ * @param depth the depth to run to
+ * @param threadCount the number of worker threads
+ * @param splitDepth the depth to split the tree into jobs at, clamped below depth
+ * @param options whether to bulk count, and the hash table shared by all threads if any
+ * @return the total nodes and time, and the nodes, jobs and time of each thread
+ */
+Perft::Result Perft::parallelPerft(ThreadPool& threadPool, const Board& board, int depth, int threadCount, int splitDepth, const Options& options) {
+    auto start = std::chrono::steady_clock::now();
+
+    Result result;
+    result.threads.resize(std::max(threadCount, 1));
+
+    if (depth == 0) {
+        result.nodes = 1;
+        return result;
+    }
+
+    //split the tree
+    Board root(board);
+    std::vector<Move> path;
+    std::vector<PerftJob> jobs;
+    collectJobs(root, std::clamp(splitDepth, 0, depth-1), path, jobs);
+
+    //count the subtrees
+    std::atomic<size_t> nextJob = 0;
+    std::vector<std::future<void>> workers;
+
+    for (ThreadStats& stats : result.threads)
+        workers.push_back(threadPool.submit([&, depth](){ runJobs(root, depth, options, jobs, nextJob, stats); }));
+    for (std::future<void>& worker : workers)
+        threadPool.waitFor(worker);
+
+    for (const ThreadStats& stats : result.threads)
+        result.nodes += stats.nodes;
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+// * --------------------------------------------- [ SUITE ] --------------------------------------------- * //
+
+/**
+ * Reads a perft suite from an EPD file, one position per line followed by its expected counts
+ * in the form "<fen> ;D1 20 ;D2 400 ;D3 8902", blank lines and lines starting with # are skipped
+ *
+ * @param path the path of the file
+ * @param suite the vector to add the positions to
+ * @return whether or not the file could be read
+ */
+bool Perft::loadSuite(const std::string& path, std::vector<SuitePosition>& suite) {
+    std::ifstream file(path);
+    if (!file)
+        return false;
+
+    for (std::string line; std::getline(file, line);) {
+        if (line.find_first_not_of(" \t\r") == std::string::npos || line[0] == '#')
+            continue;
+
+        std::stringstream fields(line);
+        SuitePosition position;
+        std::getline(fields, position.fen, ';');
+
+        for (std::string field; std::getline(fields, field, ';');) {
+            std::stringstream count(field);
+            std::string depth;
+            uint64_t nodes;
+
+            if (count >> depth >> nodes && depth.size() > 1 && (depth[0] == 'D' || depth[0] == 'd') && std::isdigit(depth[1]))
+                position.counts.emplace_back(std::stoi(depth.substr(1)), nodes);
+        }
+
+        suite.push_back(position);
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// * ----------------------------------------- [ STATIC METHODS ] ---------------------------------------- * //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//adds a job for every node at the split depth below the current board
+static void collectJobs(Board& board, size_t splitDepth, std::vector<Move>& path, std::vector<PerftJob>& jobs) {
+    if (path.size() == splitDepth) {
+        jobs.push_back({path});
+        return;
+    }
+
+    MoveList moves;
+    MoveGeneration::generateMoves(board, moves);
+
+    for (const Move& move : moves) {
+        board.makeMove(move);
+        path.push_back(move);
+
+        collectJobs(board, splitDepth, path, jobs);
+
+        path.pop_back();
+        board.unMakeMove(move);
+    }
+}
+
+//worker loop, claims and counts jobs on a private copy of the root board until there are none left
+static void runJobs(const Board& root, int depth, const Perft::Options& options, const std::vector<PerftJob>& jobs, std::atomic<size_t>& nextJob, Perft::ThreadStats& stats) {
+    auto start = std::chrono::steady_clock::now();
+
+    Board board(root);
+    uint64_t nodes = 0;
+    uint64_t jobCount = 0;
+
+    for (size_t i; (i = nextJob.fetch_add(1, std::memory_order_relaxed)) < jobs.size(); jobCount++) {
+        const std::vector<Move>& path = jobs[i].path;
+
+        for (const Move& move : path)
+            board.makeMove(move);
+
+        nodes += Perft::perft(board, depth - path.size(), options);
+
+        for (auto move = path.rbegin(); move != path.rend(); move++)
+            board.unMakeMove(*move);
+    }
+
+    stats.nodes = nodes;
+    stats.jobs = jobCount;
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
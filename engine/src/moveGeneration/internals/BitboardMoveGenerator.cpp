@@ -4,26 +4,8 @@
 #include <cstdint>
 
 #include "board/BoardUtil.hpp"
-
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// * ----------------------------------------- [ STATIC MEMBERS ] ---------------------------------------- * //
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-enum Direction {
-    NORTH,
-    EAST,
-    SOUTH,
-    WEST,
-    NORTH_EAST,
-    NORTH_WEST,
-    SOUTH_EAST,
-    SOUTH_WEST
-};
-
-static uint64_t (*const rayFunctions[])(SquareIndex) = {calcNorthMask, calcEastMask, calcSouthMask, calcWestMask, calcNorthEastMask, calcNorthWestMask, calcSouthEastMask, calcSouthWestMask};
-
-static uint64_t getPositiveRay(SquareIndex square, uint64_t occupied, Direction dir);
-static uint64_t getNegativeRay(SquareIndex square, uint64_t occupied, Direction dir);
+#include "board/BitboardTables.hpp"
+#include "moveGeneration/MagicBitboards.hpp"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // * ----------------------------------------- [ PUBLIC METHODS ] ---------------------------------------- * //
@@ -31,12 +13,9 @@ static uint64_t getNegativeRay(SquareIndex square, uint64_t occupied, Direction
 
 // * ------------------------------------------- [ KING MOVES ] ------------------------------------------ * //
 
-//generates a bitboard of all king target squares
+//generates a bitboard of all king target squares, there must be exactly one king
 uint64_t generateKingBitboard(uint64_t king, uint64_t friendlyPieces) {
-    uint64_t kingMoves = king;
-    kingMoves |= eastOne(kingMoves)  | westOne(kingMoves);
-    kingMoves |= northOne(kingMoves) | southOne(kingMoves);
-    return kingMoves & ~friendlyPieces;
+    return BitboardTables::tables.king[__builtin_ctzll(king)] & ~friendlyPieces;
 }
 
 // * ------------------------------------------ [ KNIGHT MOVES ] ----------------------------------------- * //
@@ -53,7 +32,7 @@ uint64_t generateKnightBitboard(uint64_t knights, uint64_t friendlyPieces) {
 }
 //generates a bitboard of all knight target squares
 uint64_t generateKnightBitboardSingular(SquareIndex square, uint64_t friendlyPieces) {
-    return generateKnightBitboard(1ULL << square, friendlyPieces);
+    return BitboardTables::tables.knight[square] & ~friendlyPieces;
 }
 
 // * ------------------------------------------- [ ROOK MOVES ] ------------------------------------------ * //
@@ -72,12 +51,7 @@ uint64_t generateRookBitboard(uint64_t rooks, uint64_t occupied, uint64_t friend
 }
 //generates a bitboard of all rook target squares
 uint64_t generateRookBitboardSingular(SquareIndex square, uint64_t occupied, uint64_t friendlyPieces) {
-    uint64_t moves =    getPositiveRay(square, occupied, Direction::NORTH)  |
-                        getPositiveRay(square, occupied, Direction::EAST)   |
-                        getNegativeRay(square, occupied, Direction::SOUTH)  |
-                        getNegativeRay(square, occupied, Direction::WEST)   ;
-
-    return moves & ~friendlyPieces;
+    return rookAttacks(square, occupied) & ~friendlyPieces;
 }
 
 // * ------------------------------------------ [ BISHOP MOVES ] ----------------------------------------- * //
@@ -96,12 +70,7 @@ uint64_t generateBishopBitboard(uint64_t bishops, uint64_t occupied, uint64_t fr
 }
 //generates a bitboard of all bishop target squares
 uint64_t generateBishopBitboardSingular(SquareIndex square, uint64_t occupied, uint64_t friendlyPieces) {
-    uint64_t moves =    getNegativeRay(square, occupied, Direction::SOUTH_WEST) |
-                        getPositiveRay(square, occupied, Direction::NORTH_EAST) |
-                        getPositiveRay(square, occupied, Direction::SOUTH_EAST) |
-                        getNegativeRay(square, occupied, Direction::NORTH_WEST) ;
-
-    return moves & ~friendlyPieces;
+    return bishopAttacks(square, occupied) & ~friendlyPieces;
 }
 
 // * ------------------------------------------ [ QUEEN MOVES ] ------------------------------------------ * //
@@ -120,16 +89,7 @@ uint64_t generateQueenBitboard(uint64_t queens, uint64_t occupied, uint64_t frie
 }
 //generates a bitboard of all queen target squares
 uint64_t generateQueenBitboardSingular(SquareIndex square, uint64_t occupied, uint64_t friendlyPieces) {
-    uint64_t moves =    getPositiveRay(square, occupied, Direction::NORTH)      |
-                        getPositiveRay(square, occupied, Direction::EAST)       |
-                        getNegativeRay(square, occupied, Direction::SOUTH)      |
-                        getNegativeRay(square, occupied, Direction::WEST)       |
-                        getNegativeRay(square, occupied, Direction::SOUTH_WEST) |
-                        getPositiveRay(square, occupied, Direction::NORTH_EAST) |
-                        getPositiveRay(square, occupied, Direction::SOUTH_EAST) |
-                        getNegativeRay(square, occupied, Direction::NORTH_WEST) ;
-
-    return moves & ~friendlyPieces;
+    return queenAttacks(square, occupied) & ~friendlyPieces;
 }
 
 // * ------------------------------------------- [ PAWN MOVES ] ------------------------------------------ * //
@@ -169,43 +129,15 @@ uint64_t generatePawnTargetBitboard(WhiteTurn whiteTurn, uint64_t pawns) {
         return moves;
     }
 }
-//generates a bitboard of the en passant target square if there is one
-uint64_t generateEnPassantBitboard(WhiteTurn whiteTurn, uint64_t pawns, std::array<__uint128_t, 16> enPassantData){ 
-    for (int i = 0; i < enPassantData.size(); i++) {
-        if (!(enPassantData[i] & 1)) continue;
-
-        int index = ((i % 8) * 8) + ((i > 7) ? 4 : 3);
-        uint64_t pawnBitboard = 1ULL << index;
+//generates a bitboard of the pawn that can be taken en passant if there is one
+uint64_t generateEnPassantBitboard(WhiteTurn whiteTurn, uint64_t pawns, SquareIndex enPassantSquare){ 
+    if (enPassantSquare == NO_SQUARE) return 0ULL;
 
-        if (pawnBitboard & pawns) return 0ULL;
+    uint64_t pawnBitboard = 1ULL << (whiteTurn ? southOne(enPassantSquare) : northOne(enPassantSquare));
 
-        if ((westOne(pawnBitboard) & pawns) || (eastOne(pawnBitboard) & pawns)) {
-            return pawnBitboard;
-        }
+    if ((westOne(pawnBitboard) & pawns) || (eastOne(pawnBitboard) & pawns)) {
+        return pawnBitboard;
     }
 
     return 0ULL;
 }
-
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// * ----------------------------------------- [ STATIC METHODS ] ---------------------------------------- * //
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-/**
- * Returns a bitboard of target squares from a given square in a given positive/negative direction taking into account occupied squares
- * Assumes you can still take occupied squares
- */
-static uint64_t getPositiveRay(SquareIndex square, uint64_t occupied, Direction dir) {
-    uint64_t ray = rayFunctions[dir](square);
-    uint64_t blockers = ray & occupied;
-    int firstBlocker = __builtin_ctzll(blockers | 0x8000000000000000ULL);
-    ray ^= rayFunctions[dir]((SquareIndex)firstBlocker);
-    return ray;
-}
-static uint64_t getNegativeRay(SquareIndex square, uint64_t occupied, Direction dir) {
-    uint64_t ray = rayFunctions[dir](square);
-    uint64_t blockers = ray & occupied;
-    int firstBlocker = 63 - __builtin_clzll(blockers | 1);
-    ray ^= rayFunctions[dir]((SquareIndex)firstBlocker);
-    return ray;
-}
\ No newline at end of file
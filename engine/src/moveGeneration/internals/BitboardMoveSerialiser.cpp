@@ -1,27 +1,29 @@
 #include "moveGeneration/MoveGeneratorInternals.hpp"
 
+#include <array>
 #include <cstdint>
-#include <vector>
 
 #include "board/BoardUtil.hpp"
 #include "board/Move.hpp"
+#include "board/MoveList.hpp"
 #include "board/Board.hpp"
+#include "moveGeneration/MagicBitboards.hpp"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // * ----------------------------------------- [ STATIC METHODS ] ---------------------------------------- * //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-static void addCastlingMovesWhite(std::vector<Move>& moves, const Board &board, uint64_t occupied, std::array<__uint128_t, 4> castleData);
-static void addCastlingMovesBlack(std::vector<Move>& moves, const Board &board, uint64_t occupied, std::array<__uint128_t, 4> castleData);
+static void addCastlingMovesWhite(MoveList& moves, uint64_t occupied, uint8_t castlingRights, uint64_t targeted);
+static void addCastlingMovesBlack(MoveList& moves, uint64_t occupied, uint8_t castlingRights, uint64_t targeted);
 
-static void addPawnPushMovesWhite(std::vector<Move>& moves, const Board& board, uint64_t pawns, uint64_t unoccupied);
-static void addPawnPushMovesBlack(std::vector<Move>& moves, const Board& board, uint64_t pawns, uint64_t unoccupied);
+static void addPawnPushMovesWhite(MoveList& moves, uint64_t pawns, uint64_t unoccupied, uint64_t targetMask, MoveGeneration::GenType genType);
+static void addPawnPushMovesBlack(MoveList& moves, uint64_t pawns, uint64_t unoccupied, uint64_t targetMask, MoveGeneration::GenType genType);
 
-static void addPawnAttackMovesWhite(std::vector<Move>& moves, const Board& board, uint64_t pawns, uint64_t oppositionPieces);
-static void addPawnAttackMovesBlack(std::vector<Move>& moves, const Board& board, uint64_t pawns, uint64_t oppositionPieces);
+static void addPawnAttackMovesWhite(MoveList& moves, uint64_t pawns, uint64_t oppositionPieces, MoveGeneration::GenType genType);
+static void addPawnAttackMovesBlack(MoveList& moves, uint64_t pawns, uint64_t oppositionPieces, MoveGeneration::GenType genType);
 
-static void addSinglePawnMoveWhite(std::vector<Move>& moves, const Board& board, SquareIndex startPos, SquareIndex endPos);
-static void addSinglePawnMoveBlack(std::vector<Move>& moves, const Board& board, SquareIndex startPos, SquareIndex endPos);
+static void addSinglePawnMoveWhite(MoveList& moves, SquareIndex startPos, SquareIndex endPos, MoveGeneration::GenType genType);
+static void addSinglePawnMoveBlack(MoveList& moves, SquareIndex startPos, SquareIndex endPos, MoveGeneration::GenType genType);
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // * ----------------------------------------- [ PUBLIC METHODS ] ---------------------------------------- * //
@@ -30,32 +32,32 @@ static void addSinglePawnMoveBlack(std::vector<Move>& moves, const Board& board,
 // * ------------------------------------------- [ EASY MOVES ] ------------------------------------------ * //
 
 //generates and adds all king moves to the moves reference
-void generateKingMoves(std::vector<Move>& moves, const Board& board, WhiteTurn whiteTurn, uint64_t king, uint64_t friendlyPieces) {
+void generateKingMoves(MoveList& moves, uint64_t king, uint64_t friendlyPieces, const LegalityMasks& masks) {
     const SquareIndex   startSquare = (SquareIndex)__builtin_ctzll(king);
-    const PieceType::Enum     pieceType = whiteTurn ? PieceType::WHITE_KING : PieceType::BLACK_KING;
 
-    uint64_t movesBitboard = generateKingBitboard(king, friendlyPieces);
+    uint64_t movesBitboard = generateKingBitboard(king, friendlyPieces | masks.targeted);
     while (movesBitboard) {
         SquareIndex targetSquare = (SquareIndex)__builtin_ctzll(movesBitboard);
 
-        //TODO: this method creates a temporary object for move and copies it, need to find a way to use emplace_back
-        moves.emplace_back(NORMAL, NormalMove{startSquare, targetSquare, pieceType, board.getType(targetSquare)});
+        moves.emplace_back(startSquare, targetSquare);
 
         movesBitboard &= movesBitboard-1;
     }
 }
 //generates and adds all knight moves to the moves reference
-void generateKnightMoves(std::vector<Move>& moves, const Board& board, WhiteTurn whiteTurn, uint64_t knights, uint64_t friendlyPieces) {
-    const PieceType::Enum pieceType = whiteTurn ? PieceType::WHITE_KNIGHT : PieceType::BLACK_KNIGHT;
+void generateKnightMoves(MoveList& moves, uint64_t knights, uint64_t friendlyPieces, const LegalityMasks& masks) {
+
+    //a pinned knight can never stay on its pin ray
+    knights &= ~(masks.orthogonalPins | masks.diagonalPins);
 
     while (knights) {
         SquareIndex startSquare = (SquareIndex)__builtin_ctzll(knights);
 
-        uint64_t movesBitboard = generateKnightBitboardSingular(startSquare, friendlyPieces);
+        uint64_t movesBitboard = generateKnightBitboardSingular(startSquare, friendlyPieces) & masks.checkMask;
         while (movesBitboard) {
             SquareIndex targetSquare = (SquareIndex)__builtin_ctzll(movesBitboard);
 
-            moves.emplace_back(NORMAL, NormalMove{startSquare, targetSquare, pieceType, board.getType(targetSquare)});
+            moves.emplace_back(startSquare, targetSquare);
 
             movesBitboard &= movesBitboard-1;
         }
@@ -67,17 +69,21 @@ void generateKnightMoves(std::vector<Move>& moves, const Board& board, WhiteTurn
 // * ------------------------------------------ [ SLIDING MOVES ] ---------------------------------------- * //
 
 //generates and adds all rook moves to the moves reference
-void generateRookMoves(std::vector<Move>& moves, const Board& board, WhiteTurn whiteTurn, uint64_t rooks, uint64_t occupied, uint64_t friendlyPieces) {
-    const PieceType::Enum pieceType = whiteTurn ? PieceType::WHITE_ROOK : PieceType::BLACK_ROOK;
+void generateRookMoves(MoveList& moves, uint64_t rooks, uint64_t occupied, uint64_t friendlyPieces, const LegalityMasks& masks) {
+
+    //a diagonally pinned rook can't move
+    rooks &= ~masks.diagonalPins;
 
     while (rooks) {
         SquareIndex startSquare = (SquareIndex)__builtin_ctzll(rooks);
 
-        uint64_t movesBitboard = generateRookBitboardSingular(startSquare, occupied, friendlyPieces);
+        uint64_t movesBitboard = generateRookBitboardSingular(startSquare, occupied, friendlyPieces) & masks.checkMask;
+        if ((1ULL << startSquare) & masks.orthogonalPins)
+            movesBitboard &= masks.orthogonalPins;
         while (movesBitboard) {
             SquareIndex targetSquare = (SquareIndex)__builtin_ctzll(movesBitboard);
 
-            moves.emplace_back(NORMAL, NormalMove{startSquare, targetSquare, pieceType, board.getType(targetSquare)});
+            moves.emplace_back(startSquare, targetSquare);
 
             movesBitboard &= movesBitboard-1;
         }
@@ -86,17 +92,21 @@ void generateRookMoves(std::vector<Move>& moves, const Board& board, WhiteTurn w
     }
 }
 //generates and adds all bishop moves to the moves reference
-void generateBishopMoves(std::vector<Move>& moves, const Board& board, WhiteTurn whiteTurn, uint64_t bishops, uint64_t occupied, uint64_t friendlyPieces) {
-    const PieceType::Enum pieceType = whiteTurn ? PieceType::WHITE_BISHOP : PieceType::BLACK_BISHOP;
+void generateBishopMoves(MoveList& moves, uint64_t bishops, uint64_t occupied, uint64_t friendlyPieces, const LegalityMasks& masks) {
+
+    //an orthogonally pinned bishop can't move
+    bishops &= ~masks.orthogonalPins;
 
     while (bishops) {
         SquareIndex startSquare = (SquareIndex)__builtin_ctzll(bishops);
 
-        uint64_t movesBitboard = generateBishopBitboardSingular(startSquare, occupied, friendlyPieces);
+        uint64_t movesBitboard = generateBishopBitboardSingular(startSquare, occupied, friendlyPieces) & masks.checkMask;
+        if ((1ULL << startSquare) & masks.diagonalPins)
+            movesBitboard &= masks.diagonalPins;
         while (movesBitboard) {
             SquareIndex targetSquare = (SquareIndex)__builtin_ctzll(movesBitboard);
 
-            moves.emplace_back(NORMAL, NormalMove{startSquare, targetSquare, pieceType, board.getType(targetSquare)});
+            moves.emplace_back(startSquare, targetSquare);
 
             movesBitboard &= movesBitboard-1;
         }
@@ -105,17 +115,26 @@ void generateBishopMoves(std::vector<Move>& moves, const Board& board, WhiteTurn
     }
 }
 //generates and adds all queen moves to the moves reference
-void generateQueenMoves(std::vector<Move>& moves, const Board& board, WhiteTurn whiteTurn, uint64_t queens, uint64_t occupied, uint64_t friendlyPieces) {
-    const PieceType::Enum pieceType = whiteTurn ? PieceType::WHITE_QUEEN : PieceType::BLACK_QUEEN;
+void generateQueenMoves(MoveList& moves, uint64_t queens, uint64_t occupied, uint64_t friendlyPieces, const LegalityMasks& masks) {
 
     while (queens) {
         SquareIndex startSquare = (SquareIndex)__builtin_ctzll(queens);
-
-        uint64_t movesBitboard = generateQueenBitboardSingular(startSquare, occupied, friendlyPieces);
+        uint64_t startBitboard = 1ULL << startSquare;
+
+        //a pinned queen can only move like a rook or bishop along its pin ray
+        uint64_t movesBitboard;
+        if (startBitboard & masks.orthogonalPins)
+            movesBitboard = generateRookBitboardSingular(startSquare, occupied, friendlyPieces) & masks.orthogonalPins;
+        else if (startBitboard & masks.diagonalPins)
+            movesBitboard = generateBishopBitboardSingular(startSquare, occupied, friendlyPieces) & masks.diagonalPins;
+        else
+            movesBitboard = generateQueenBitboardSingular(startSquare, occupied, friendlyPieces);
+
+        movesBitboard &= masks.checkMask;
         while (movesBitboard) {
             SquareIndex targetSquare = (SquareIndex)__builtin_ctzll(movesBitboard);
 
-            moves.emplace_back(NORMAL, NormalMove{startSquare, targetSquare, pieceType, board.getType(targetSquare)});
+            moves.emplace_back(startSquare, targetSquare);
 
             movesBitboard &= movesBitboard-1;
         }
@@ -126,45 +145,66 @@ void generateQueenMoves(std::vector<Move>& moves, const Board& board, WhiteTurn
 
 // * -------------------------------------- [ PAWN & SPECIAL MOVES ] ------------------------------------- * //
 
-//generates and adds all pawn moves to the moves reference
-void generatePawnMoves(std::vector<Move>& moves, const Board& board, WhiteTurn whiteTurn, uint64_t pawns, uint64_t unoccupied, uint64_t oppositionPieces) {
+//generates and adds the pawn moves of the given type to the moves reference, promotions are split by piece
+//with queen promotions counting as captures and under promotions as quiets
+void generatePawnMoves(MoveList& moves, WhiteTurn whiteTurn, uint64_t pawns, uint64_t unoccupied, uint64_t oppositionPieces, const LegalityMasks& masks, MoveGeneration::GenType genType) {
+    const uint64_t promotionRank    = whiteTurn ? 0x8080808080808080ULL : 0x0101010101010101ULL;
+
+    //pinned pawns can only push along an orthogonal pin, and only capture along a diagonal pin
+    const uint64_t unpinnedPawns    = pawns & ~(masks.orthogonalPins | masks.diagonalPins);
+    const uint64_t pushPinnedPawns  = pawns & masks.orthogonalPins;
+    const uint64_t takePinnedPawns  = pawns & masks.diagonalPins;
+    const uint64_t pushTargets      = masks.checkMask & (genType == MoveGeneration::CAPTURES ? promotionRank : ~0ULL);
+    const uint64_t takeTargets      = oppositionPieces & masks.checkMask & (genType == MoveGeneration::QUIETS ? promotionRank : ~0ULL);
+
     if (whiteTurn) {
-        addPawnPushMovesWhite(moves, board, pawns, unoccupied);
-        addPawnAttackMovesWhite(moves, board, pawns, oppositionPieces);
+        addPawnPushMovesWhite(moves, unpinnedPawns, unoccupied, pushTargets, genType);
+        addPawnPushMovesWhite(moves, pushPinnedPawns, unoccupied, pushTargets & masks.orthogonalPins, genType);
+        addPawnAttackMovesWhite(moves, unpinnedPawns, takeTargets, genType);
+        addPawnAttackMovesWhite(moves, takePinnedPawns, takeTargets & masks.diagonalPins, genType);
     }
     else {
-        addPawnPushMovesBlack(moves, board, pawns, unoccupied);
-        addPawnAttackMovesBlack(moves, board, pawns, oppositionPieces);
+        addPawnPushMovesBlack(moves, unpinnedPawns, unoccupied, pushTargets, genType);
+        addPawnPushMovesBlack(moves, pushPinnedPawns, unoccupied, pushTargets & masks.orthogonalPins, genType);
+        addPawnAttackMovesBlack(moves, unpinnedPawns, takeTargets, genType);
+        addPawnAttackMovesBlack(moves, takePinnedPawns, takeTargets & masks.diagonalPins, genType);
     }
 }
 //generates and adds all castling moves to the moves reference
-void generateCastlingMoves(std::vector<Move>& moves, const Board& board, WhiteTurn whiteTurn, uint64_t occupied, std::array<__uint128_t, 4> castleData) {
+void generateCastlingMoves(MoveList& moves, WhiteTurn whiteTurn, uint64_t occupied, uint8_t castlingRights, const LegalityMasks& masks) {
     if (whiteTurn)
-        addCastlingMovesWhite(moves, board, occupied, castleData);
+        addCastlingMovesWhite(moves, occupied, castlingRights, masks.targeted);
     else
-        addCastlingMovesBlack(moves, board, occupied, castleData);
+        addCastlingMovesBlack(moves, occupied, castlingRights, masks.targeted);
 }
 //generates and adds all en passant moves to the moves reference
-void generateEnPassantMoves(std::vector<Move>& moves, const Board& board, WhiteTurn whiteTurn, uint64_t pawns, std::array<__uint128_t, 16> enPassantData) {
-    //very cursed line. I could of just put the ternary in the two lines that this is used as its just as efficient time wise and more efficient space wise but this looks cooler
-    SquareIndex (*forwardOne)(int) = whiteTurn ? (SquareIndex(*)(int))northOne : (SquareIndex(*)(int))southOne;
-    PieceType::Enum pieceType = whiteTurn ? PieceType::WHITE_PAWN : PieceType::BLACK_PAWN;
-    PieceType::Enum killPieceType = whiteTurn ? PieceType::BLACK_PAWN : PieceType::WHITE_PAWN;
+void generateEnPassantMoves(MoveList& moves, const Board& board, WhiteTurn whiteTurn, uint64_t pawns, SquareIndex enPassantSquare, const LegalityMasks& masks) {
+    if (enPassantSquare == NO_SQUARE) return;
 
-    for (int i = 0; i < enPassantData.size(); i++) {
-        if (!(enPassantData[i] & 1)) continue;
+    const std::array<uint64_t, 14>& bitBoards = board.getBitBoards();
+    const short indexOffset = whiteTurn ? 0 : PieceType::BLACK-PieceType::WHITE;
+    const short oppositionOffset = whiteTurn ? PieceType::BLACK-PieceType::WHITE : 0;
 
-        int killIndex = ((i % 8) * 8) + ((i > 7) ? 4 : 3);
-        uint64_t pawnBitboard = 1ULL << killIndex;
+    SquareIndex killIndex = whiteTurn ? southOne(enPassantSquare) : northOne(enPassantSquare);
+    uint64_t pawnBitboard = 1ULL << killIndex;
 
-        if (pawnBitboard & pawns) return;
+    //must take the checking pawn or block the check
+    if (!((pawnBitboard | (1ULL << enPassantSquare)) & masks.checkMask)) return;
 
-        if (westOne(pawnBitboard) & pawns) {
-            moves.emplace_back(EN_PASSANT, EnPassantMove{westOne(killIndex), forwardOne(killIndex), pieceType, (SquareIndex)killIndex, killPieceType});
-        }
-        if (eastOne(pawnBitboard) & pawns) {
-            moves.emplace_back(EN_PASSANT, EnPassantMove{eastOne(killIndex), forwardOne(killIndex), pieceType, (SquareIndex)killIndex, killPieceType});
-        }
+    //two pawns leave the same rank at once, so check for sliders seeing the king directly instead of using the pin masks
+    SquareIndex kingIndex = (SquareIndex)__builtin_ctzll(bitBoards[PieceType::WHITE_KING + indexOffset]);
+    uint64_t oppositionQueens = bitBoards[PieceType::WHITE_QUEEN + oppositionOffset];
+    uint64_t oppositionRooks = bitBoards[PieceType::WHITE_ROOK + oppositionOffset] | oppositionQueens;
+    uint64_t oppositionBishops = bitBoards[PieceType::WHITE_BISHOP + oppositionOffset] | oppositionQueens;
+
+    for (uint64_t startBitboard : {westOne(pawnBitboard), eastOne(pawnBitboard)}) {
+        if (!(startBitboard & pawns)) continue;
+        SquareIndex startIndex = (SquareIndex)__builtin_ctzll(startBitboard);
+
+        uint64_t occupied = (bitBoards[PieceType::WHITE_PIECES] | bitBoards[PieceType::BLACK_PIECES] | (1ULL << enPassantSquare)) & ~startBitboard & ~pawnBitboard;
+        if ((rookAttacks(kingIndex, occupied) & oppositionRooks) || (bishopAttacks(kingIndex, occupied) & oppositionBishops)) continue;
+
+        moves.emplace_back(startIndex, enPassantSquare, EN_PASSANT);
     }
 }
 
@@ -175,57 +215,48 @@ void generateEnPassantMoves(std::vector<Move>& moves, const Board& board, WhiteT
 // * ------------------------------------------ [ CASTLING MOVES ] --------------------------------------- * //
 
 //generates and adds all white castling moves to the moves reference
-static void addCastlingMovesWhite(std::vector<Move>& moves, const Board &board, uint64_t occupied, std::array<__uint128_t, 4> castleData) {
-    if (castleData[CastlePieces::W_KING]  == 0 && (occupied & (uint64_t)(0x0001010000000000)) == 0) {
-        if (!isTargeted(board, WhiteTurn{false}, SquareIndex::e1) && !isTargeted(board, WhiteTurn{false}, SquareIndex::f1)) {
-            moves.emplace_back(CASTLE, CastleMove{e1, g1, PieceType::WHITE_KING, h1, f1, PieceType::WHITE_ROOK});
-        }
+static void addCastlingMovesWhite(MoveList& moves, uint64_t occupied, uint8_t castlingRights, uint64_t targeted) {
+    //the squares between the king and rook must be empty, and the king can't be in, pass through, or end in check
+    if ((castlingRights & CASTLE_RIGHT(CastlePieces::W_KING)) && !(occupied & 0x0001010000000000ULL) && !(targeted & 0x0001010100000000ULL)) {
+        moves.emplace_back(e1, g1, CASTLE);
     }
-    if (castleData[CastlePieces::W_QUEEN] == 0 && (occupied & (uint64_t)(0x0000000001010100)) == 0) {
-        if (!isTargeted(board, WhiteTurn{false}, SquareIndex::e1) && !isTargeted(board, WhiteTurn{false}, SquareIndex::d1)) {
-            moves.emplace_back(CASTLE, CastleMove{e1, c1, PieceType::WHITE_KING, a1, d1, PieceType::WHITE_ROOK});
-        }
+    if ((castlingRights & CASTLE_RIGHT(CastlePieces::W_QUEEN)) && !(occupied & 0x0000000001010100ULL) && !(targeted & 0x0000000101010000ULL)) {
+        moves.emplace_back(e1, c1, CASTLE);
     }
 }
 //generates and adds all black castling moves to the moves reference
-static void addCastlingMovesBlack(std::vector<Move>& moves, const Board &board, uint64_t occupied, std::array<__uint128_t, 4> castleData) {
-    if (!castleData[CastlePieces::B_KING] && !(occupied & (uint64_t)(0x0080800000000000))) {
-        if (!isTargeted(board, WhiteTurn{true}, SquareIndex::e8) && !isTargeted(board, WhiteTurn{true}, SquareIndex::f8)) {
-            moves.emplace_back(CASTLE, CastleMove{e8, g8, PieceType::BLACK_KING, h8, f8, PieceType::BLACK_ROOK});
-        }
+static void addCastlingMovesBlack(MoveList& moves, uint64_t occupied, uint8_t castlingRights, uint64_t targeted) {
+    if ((castlingRights & CASTLE_RIGHT(CastlePieces::B_KING)) && !(occupied & 0x0080800000000000ULL) && !(targeted & 0x0080808000000000ULL)) {
+        moves.emplace_back(e8, g8, CASTLE);
     }
-    if (!castleData[CastlePieces::B_QUEEN] && !(occupied & (uint64_t)(0x0000000080808000))) {
-        if (!isTargeted(board, WhiteTurn{true}, SquareIndex::e8) && !isTargeted(board, WhiteTurn{true}, SquareIndex::d8)) {
-            moves.emplace_back(CASTLE, CastleMove{e8, c8, PieceType::BLACK_KING, a8, d8, PieceType::BLACK_ROOK});
-        }
+    if ((castlingRights & CASTLE_RIGHT(CastlePieces::B_QUEEN)) && !(occupied & 0x0000000080808000ULL) && !(targeted & 0x0000008080800000ULL)) {
+        moves.emplace_back(e8, c8, CASTLE);
     }
 }
 
 // * ------------------------------------------- [ EASY MOVES ] ------------------------------------------ * //
 
-//generates and adds all white pawn push moves to the moves reference
-static void addPawnPushMovesWhite(std::vector<Move>& moves, const Board& board, uint64_t pawns, uint64_t unoccupied) {
-    uint64_t pushMoves = generatePawnPushBitboard(WhiteTurn{true}, pawns, unoccupied);
+//generates and adds all white pawn push moves landing on the target mask to the moves reference
+static void addPawnPushMovesWhite(MoveList& moves, uint64_t pawns, uint64_t unoccupied, uint64_t targetMask, MoveGeneration::GenType genType) {
+    uint64_t singlePushes = northOne(pawns) & unoccupied;
+    uint64_t doublePushes = northOne(singlePushes) & unoccupied & 0x0808080808080808ULL;
 
-    while (pushMoves) {
-        SquareIndex targetSquareIndex = (SquareIndex)__builtin_ctzll(pushMoves);
-        uint64_t targetSquare = 1ULL << targetSquareIndex;
-
-        //add single push move
-        addSinglePawnMoveWhite(moves, board, southOne(targetSquareIndex), targetSquareIndex);
-
-        pushMoves &= pushMoves-1;
-
-        if (northOne(targetSquare) & pushMoves) {
-            //add double push move
-            addSinglePawnMoveWhite(moves, board, southOne(targetSquareIndex), northOne(targetSquareIndex));
+    singlePushes &= targetMask;
+    doublePushes &= targetMask;
 
-            pushMoves &= pushMoves-1;
-        }
+    while (singlePushes) {
+        SquareIndex targetSquareIndex = (SquareIndex)__builtin_ctzll(singlePushes);
+        addSinglePawnMoveWhite(moves, southOne(targetSquareIndex), targetSquareIndex, genType);
+        singlePushes &= singlePushes-1;
+    }
+    while (doublePushes) {
+        SquareIndex targetSquareIndex = (SquareIndex)__builtin_ctzll(doublePushes);
+        addSinglePawnMoveWhite(moves, southOne(southOne(targetSquareIndex)), targetSquareIndex, genType);
+        doublePushes &= doublePushes-1;
     }
 }
 //generates and adds all white pawn attack moves to the moves reference
-static void addPawnAttackMovesWhite(std::vector<Move>& moves, const Board& board, uint64_t pawns, uint64_t oppositionPieces) {
+static void addPawnAttackMovesWhite(MoveList& moves, uint64_t pawns, uint64_t oppositionPieces, MoveGeneration::GenType genType) {
     uint64_t attackMoves = generatePawnAttackBitboard(WhiteTurn{true}, pawns, oppositionPieces);
 
     while (attackMoves) {
@@ -233,55 +264,54 @@ static void addPawnAttackMovesWhite(std::vector<Move>& moves, const Board& board
         uint64_t targetSquare = 1ULL << targetSquareIndex;
 
         if (southEastOne(targetSquare) & pawns) {
-            addSinglePawnMoveWhite(moves, board, southEastOne(targetSquareIndex), targetSquareIndex);
+            addSinglePawnMoveWhite(moves, southEastOne(targetSquareIndex), targetSquareIndex, genType);
         }
         if (southWestOne(targetSquare) & pawns) {
-            addSinglePawnMoveWhite(moves, board, southWestOne(targetSquareIndex), targetSquareIndex);
+            addSinglePawnMoveWhite(moves, southWestOne(targetSquareIndex), targetSquareIndex, genType);
         }
 
         attackMoves &= attackMoves-1;
     }
 }
 //adds a single white pawn move to the moves reference
-static void addSinglePawnMoveWhite(std::vector<Move>& moves, const Board& board, SquareIndex startPos, SquareIndex endPos) {
+static void addSinglePawnMoveWhite(MoveList& moves, SquareIndex startPos, SquareIndex endPos, MoveGeneration::GenType genType) {
     if ((1ULL << endPos) & 0x8080808080808080) {
         //promotion moves
-        moves.emplace_back(PROMOTION, PromotionMove{startPos, endPos, PieceType::WHITE_PAWN, PieceType::WHITE_QUEEN,  board.getType(endPos)});
-        moves.emplace_back(PROMOTION, PromotionMove{startPos, endPos, PieceType::WHITE_PAWN, PieceType::WHITE_BISHOP, board.getType(endPos)});
-        moves.emplace_back(PROMOTION, PromotionMove{startPos, endPos, PieceType::WHITE_PAWN, PieceType::WHITE_KNIGHT, board.getType(endPos)});
-        moves.emplace_back(PROMOTION, PromotionMove{startPos, endPos, PieceType::WHITE_PAWN, PieceType::WHITE_ROOK,   board.getType(endPos)});
+        if (genType != MoveGeneration::QUIETS)
+            moves.emplace_back(startPos, endPos, PROMOTION, QUEEN);
+        if (genType != MoveGeneration::CAPTURES) {
+            moves.emplace_back(startPos, endPos, PROMOTION, BISHOP);
+            moves.emplace_back(startPos, endPos, PROMOTION, KNIGHT);
+            moves.emplace_back(startPos, endPos, PROMOTION, ROOK);
+        }
     }
     else {
         //normal move
-        moves.emplace_back(NORMAL, NormalMove{startPos, endPos, PieceType::WHITE_PAWN, board.getType(endPos)});
+        moves.emplace_back(startPos, endPos);
     }
 }
 
-//generates and adds all black pawn push moves to the moves reference
-static void addPawnPushMovesBlack(std::vector<Move>& moves, const Board& board, uint64_t pawns, uint64_t unoccupied) {
-    uint64_t pushMoves = generatePawnPushBitboard(WhiteTurn{false}, pawns, unoccupied);
+//generates and adds all black pawn push moves landing on the target mask to the moves reference
+static void addPawnPushMovesBlack(MoveList& moves, uint64_t pawns, uint64_t unoccupied, uint64_t targetMask, MoveGeneration::GenType genType) {
+    uint64_t singlePushes = southOne(pawns) & unoccupied;
+    uint64_t doublePushes = southOne(singlePushes) & unoccupied & 0x1010101010101010ULL;
 
-    while (pushMoves) {
-        SquareIndex targetSquareIndex = (SquareIndex)__builtin_ctzll(pushMoves);
-        uint64_t targetSquare = 1ULL << targetSquareIndex;
-
-        if (northOne(targetSquare) & pushMoves) {
-            //add double and single push move
-            addSinglePawnMoveBlack(moves, board, northOne(northOne(targetSquareIndex)), targetSquareIndex);
-            addSinglePawnMoveBlack(moves, board, northOne(northOne(targetSquareIndex)), northOne(targetSquareIndex));
+    singlePushes &= targetMask;
+    doublePushes &= targetMask;
 
-            pushMoves &= pushMoves-1;
-        }
-        else {
-            //add single push move
-            addSinglePawnMoveBlack(moves, board, northOne(targetSquareIndex), targetSquareIndex);
-        }
-
-        pushMoves &= pushMoves-1;
+    while (singlePushes) {
+        SquareIndex targetSquareIndex = (SquareIndex)__builtin_ctzll(singlePushes);
+        addSinglePawnMoveBlack(moves, northOne(targetSquareIndex), targetSquareIndex, genType);
+        singlePushes &= singlePushes-1;
+    }
+    while (doublePushes) {
+        SquareIndex targetSquareIndex = (SquareIndex)__builtin_ctzll(doublePushes);
+        addSinglePawnMoveBlack(moves, northOne(northOne(targetSquareIndex)), targetSquareIndex, genType);
+        doublePushes &= doublePushes-1;
     }
 }
 //generates and adds all black pawn attack moves to the moves reference
-static void addPawnAttackMovesBlack(std::vector<Move>& moves, const Board& board, uint64_t pawns, uint64_t oppositionPieces) {
+static void addPawnAttackMovesBlack(MoveList& moves, uint64_t pawns, uint64_t oppositionPieces, MoveGeneration::GenType genType) {
     uint64_t attackMoves = generatePawnAttackBitboard(WhiteTurn{false}, pawns, oppositionPieces);
     
     while (attackMoves) {
@@ -289,26 +319,29 @@ static void addPawnAttackMovesBlack(std::vector<Move>& moves, const Board& board
         uint64_t targetSquare = 1ULL << targetSquareIndex;
         
         if (northEastOne(targetSquare) & pawns) {
-            addSinglePawnMoveBlack(moves, board, northEastOne(targetSquareIndex), targetSquareIndex);
+            addSinglePawnMoveBlack(moves, northEastOne(targetSquareIndex), targetSquareIndex, genType);
         }
         if (northWestOne(targetSquare) & pawns) {
-            addSinglePawnMoveBlack(moves, board, northWestOne(targetSquareIndex), targetSquareIndex);
+            addSinglePawnMoveBlack(moves, northWestOne(targetSquareIndex), targetSquareIndex, genType);
         }
 
         attackMoves &= attackMoves-1;
     }
 }
 //adds a single black pawn move to the moves reference
-static void addSinglePawnMoveBlack(std::vector<Move>& moves, const Board& board, SquareIndex startPos, SquareIndex endPos) {
+static void addSinglePawnMoveBlack(MoveList& moves, SquareIndex startPos, SquareIndex endPos, MoveGeneration::GenType genType) {
     if ((1ULL << endPos) & 0x0101010101010101) {
         //promotion moves
-        moves.emplace_back(PROMOTION, PromotionMove{startPos, endPos, PieceType::BLACK_PAWN, PieceType::BLACK_QUEEN,  board.getType(endPos)});
-        moves.emplace_back(PROMOTION, PromotionMove{startPos, endPos, PieceType::BLACK_PAWN, PieceType::BLACK_BISHOP, board.getType(endPos)});
-        moves.emplace_back(PROMOTION, PromotionMove{startPos, endPos, PieceType::BLACK_PAWN, PieceType::BLACK_KNIGHT, board.getType(endPos)});
-        moves.emplace_back(PROMOTION, PromotionMove{startPos, endPos, PieceType::BLACK_PAWN, PieceType::BLACK_ROOK,   board.getType(endPos)});
+        if (genType != MoveGeneration::QUIETS)
+            moves.emplace_back(startPos, endPos, PROMOTION, QUEEN);
+        if (genType != MoveGeneration::CAPTURES) {
+            moves.emplace_back(startPos, endPos, PROMOTION, BISHOP);
+            moves.emplace_back(startPos, endPos, PROMOTION, KNIGHT);
+            moves.emplace_back(startPos, endPos, PROMOTION, ROOK);
+        }
     }
     else {
         //normal move
-        moves.emplace_back(NORMAL, NormalMove{startPos, endPos, PieceType::BLACK_PAWN, board.getType(endPos)});
+        moves.emplace_back(startPos, endPos);
     }
 }
@@ -0,0 +1,166 @@
+#include "moveGeneration/MagicBitboards.hpp"
+
+#include <cassert>
+#include <cstdint>
+
+#include "board/BoardUtil.hpp"
+#include "board/BitboardTables.hpp"
+
+using namespace BitboardTables;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// * ----------------------------------------- [ STATIC MEMBERS ] ---------------------------------------- * //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//found offline with a random search, they map every relevant occupancy of their square to an index without destructive collisions
+static const uint64_t ROOK_MAGICS[64] = {
+    0x1080004008801020ULL, 0x0840092002C03000ULL, 0x1900200010400900ULL, 0x0880100008000480ULL,
+    0x4200100420080200ULL, 0x8100020100080400ULL, 0x0200040110886200ULL, 0x0200008040220411ULL,
+    0x0404800084400220ULL, 0x0000401000402000ULL, 0x0086001081220440ULL, 0x0408800800100280ULL,
+    0x000A001201040820ULL, 0x8848800200840080ULL, 0x4001000100040200ULL, 0x0442000102105084ULL,
+    0x9080010020804100ULL, 0x0040404000201009ULL, 0x0000808010002009ULL, 0x2200090021D00100ULL,
+    0x0008008008040080ULL, 0x0004004002010040ULL, 0x0011040008015042ULL, 0x00000A0001768104ULL,
+    0x0000800080204009ULL, 0x2010004140002001ULL, 0x9800200280100080ULL, 0x1000100080080080ULL,
+    0x0442000A00049020ULL, 0x2100040080020080ULL, 0x0800120400900148ULL, 0x0010040A00128541ULL,
+    0x2800804000800030ULL, 0x1010002000400041ULL, 0x4000200011004100ULL, 0x0610008410800800ULL,
+    0x0400802402800800ULL, 0xC100020080800400ULL, 0x0002000802000401ULL, 0x0182085882000401ULL,
+    0x0220204000808000ULL, 0x2860100040024022ULL, 0x0001002004110040ULL, 0x99101042000A0020ULL,
+    0x0004080004008080ULL, 0x0010040002008080ULL, 0x2012004881020004ULL, 0x8300842444820011ULL,
+    0x0088403882010200ULL, 0x0820400080210100ULL, 0x0110910040A00300ULL, 0x0801100280080480ULL,
+    0x0242009008200600ULL, 0x1002000489500200ULL, 0x0040800200010080ULL, 0x0091800041000080ULL,
+    0x0000209300488001ULL, 0x04C1002414824001ULL, 0x020020000B001041ULL, 0x7000100004200901ULL,
+    0x8002002004100802ULL, 0x30010002084C0007ULL, 0x0888221800813004ULL, 0x4000002840840112ULL
+};
+static const uint64_t BISHOP_MAGICS[64] = {
+    0x8210103483004200ULL, 0x0008022802002820ULL, 0x0404810401000010ULL, 0x4004043280808044ULL,
+    0x0181104004600101ULL, 0x8802021104000000ULL, 0x000111011041A000ULL, 0x4000420890211000ULL,
+    0x3200109001080880ULL, 0x0002E0810A0A0840ULL, 0x2040840802004228ULL, 0x9200110408800000ULL,
+    0x0000C45040020100ULL, 0x0200088824401000ULL, 0x0000110690104804ULL, 0x04010A4400A41006ULL,
+    0x01C100D03001A100ULL, 0x9820220481020A00ULL, 0x520D263000420040ULL, 0x0180810802004102ULL,
+    0x0002001016100000ULL, 0x0200800808010828ULL, 0x0002402C88081800ULL, 0x4018400A82009080ULL,
+    0x441005010A200402ULL, 0x4024041143880802ULL, 0x0200280210004940ULL, 0xA201004024004200ULL,
+    0x8000840184802000ULL, 0x0800820080880C00ULL, 0x1008004821040202ULL, 0x0000921019820280ULL,
+    0x0102084100045001ULL, 0xA590820820200802ULL, 0x0104020200010409ULL, 0x0000A00800210106ULL,
+    0x0001020401020102ULL, 0x0508080021011000ULL, 0x0058162850140100ULL, 0x0002040020004212ULL,
+    0x000801108A001000ULL, 0x0A408090100008C2ULL, 0x0000101804002800ULL, 0x0000004200821800ULL,
+    0x0020049008800401ULL, 0x02C8015004080480ULL, 0x8804014414000110ULL, 0x0008011042000080ULL,
+    0x04010C8290400010ULL, 0x0382048208232402ULL, 0x1000202108080140ULL, 0x008000120A020100ULL,
+    0x108C0011A2020004ULL, 0x010004200421100EULL, 0x8820200409105000ULL, 0x0108300400802840ULL,
+    0x0402008049282000ULL, 0x0000002402080480ULL, 0x08001C0422017001ULL, 0x000200001420A801ULL,
+    0x2010C20011020204ULL, 0x3000308461444500ULL, 0x1000040404C80200ULL, 0x0825011019060080ULL
+};
+
+static uint64_t rookTable[0x19000];     //sum of 2^(relevant bits) over every square
+static uint64_t bishopTable[0x1480];
+
+SliderMagic rookMagics[64];
+SliderMagic bishopMagics[64];
+bool usePext = false;
+
+static uint64_t getPositiveRay(SquareIndex square, uint64_t occupied, Direction dir);
+static uint64_t getNegativeRay(SquareIndex square, uint64_t occupied, Direction dir);
+
+static uint64_t slowRookAttacks(SquareIndex square, uint64_t occupied);
+static uint64_t slowBishopAttacks(SquareIndex square, uint64_t occupied);
+
+static uint64_t rookRelevantMask(SquareIndex square);
+static uint64_t bishopRelevantMask(SquareIndex square);
+
+static void initSlider(SliderMagic magics[], uint64_t table[], const uint64_t magicNumbers[], uint64_t (*slowAttacks)(SquareIndex, uint64_t), uint64_t (*edgeMask)(SquareIndex));
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// * ----------------------------------------- [ PUBLIC METHODS ] ---------------------------------------- * //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Fills the rook and bishop attack tables, indexed using pext if the cpu supports it and magics otherwise
+ */
+void initSliderAttacks() {
+#if defined(__x86_64__)
+    usePext = __builtin_cpu_supports("bmi2");
+#endif
+
+    initSlider(rookMagics, rookTable, ROOK_MAGICS, slowRookAttacks, rookRelevantMask);
+    initSlider(bishopMagics, bishopTable, BISHOP_MAGICS, slowBishopAttacks, bishopRelevantMask);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// * ----------------------------------------- [ STATIC METHODS ] ---------------------------------------- * //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Fills the attack table for one slider type, looking up the attacks for every subset of every squares relevant occupancy
+ *
+ * @param magics the per square lookup data to fill
+ * @param table the attack table to fill, large enough for every square
+ * @param magicNumbers the magic for each square
+ * @param slowAttacks function calculating the attacks for a given square and occupancy using rays
+ * @param edgeMask function returning the relevant occupancy for a given square
+ */
+static void initSlider(SliderMagic magics[], uint64_t table[], const uint64_t magicNumbers[], uint64_t (*slowAttacks)(SquareIndex, uint64_t), uint64_t (*edgeMask)(SquareIndex)) {
+    uint64_t* tableSlice = table;
+
+    for (int square = 0; square < 64; square++) {
+        SliderMagic& m = magics[square];
+        m.mask = edgeMask((SquareIndex)square);
+        m.magic = magicNumbers[square];
+        m.shift = 64 - __builtin_popcountll(m.mask);
+        m.attacks = tableSlice;
+
+        //enumerate every subset of the mask with the carry-rippler trick
+        uint64_t subset = 0;
+        do {
+            uint64_t attacks = slowAttacks((SquareIndex)square, subset);
+            uint64_t index = sliderIndex(m, subset);
+
+            assert(usePext || m.attacks[index] == 0 || m.attacks[index] == attacks);
+            m.attacks[index] = attacks;
+
+            subset = (subset - m.mask) & m.mask;
+        } while (subset);
+
+        tableSlice += 1ULL << __builtin_popcountll(m.mask);
+    }
+}
+
+//the attack sets used to fill the tables, calculated by walking each ray up to its first blocker
+static uint64_t slowRookAttacks(SquareIndex square, uint64_t occupied) {
+    return  getPositiveRay(square, occupied, Direction::NORTH)  |
+            getPositiveRay(square, occupied, Direction::EAST)   |
+            getNegativeRay(square, occupied, Direction::SOUTH)  |
+            getNegativeRay(square, occupied, Direction::WEST)   ;
+}
+static uint64_t slowBishopAttacks(SquareIndex square, uint64_t occupied) {
+    return  getNegativeRay(square, occupied, Direction::SOUTH_WEST) |
+            getPositiveRay(square, occupied, Direction::NORTH_EAST) |
+            getPositiveRay(square, occupied, Direction::SOUTH_EAST) |
+            getNegativeRay(square, occupied, Direction::NORTH_WEST) ;
+}
+
+//the squares whose occupancy can change the attacks, i.e. the rays excluding the board edges they run into
+static uint64_t rookRelevantMask(SquareIndex square) {
+    return  (calcNorthMask(square) & ~0x8080808080808080ULL) | (calcSouthMask(square) & ~0x0101010101010101ULL) |
+            (calcEastMask(square)  & ~0xFF00000000000000ULL) | (calcWestMask(square)  & ~0x00000000000000FFULL) ;
+}
+static uint64_t bishopRelevantMask(SquareIndex square) {
+    return slowBishopAttacks(square, 0) & ~0xFF818181818181FFULL;
+}
+
+/**
+ * Returns a bitboard of target squares from a given square in a given positive/negative direction taking into account occupied squares
+ * Assumes you can still take occupied squares
+ */
+static uint64_t getPositiveRay(SquareIndex square, uint64_t occupied, Direction dir) {
+    uint64_t ray = tables.rays[dir][square];
+    uint64_t blockers = ray & occupied;
+    int firstBlocker = __builtin_ctzll(blockers | 0x8000000000000000ULL);
+    ray ^= tables.rays[dir][firstBlocker];
+    return ray;
+}
+static uint64_t getNegativeRay(SquareIndex square, uint64_t occupied, Direction dir) {
+    uint64_t ray = tables.rays[dir][square];
+    uint64_t blockers = ray & occupied;
+    int firstBlocker = 63 - __builtin_clzll(blockers | 1);
+    ray ^= tables.rays[dir][firstBlocker];
+    return ray;
+}
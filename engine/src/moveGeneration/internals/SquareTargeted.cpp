@@ -1,5 +1,9 @@
 #include "board/BoardUtil.hpp"
+#include "board/BitboardTables.hpp"
 #include "moveGeneration/MoveGeneratorInternals.hpp"
+#include "moveGeneration/MagicBitboards.hpp"
+
+using BitboardTables::tables;
 
 /**
  * Returns if a specific square is being targeted by any pseduo legal move in a given position 
@@ -15,29 +19,124 @@ bool isTargeted(const Board& board, WhiteTurn whiteTurn, SquareIndex i) {
     
     //constant values including the bitboards and masks
     const std::array<uint64_t, 14>&     bitBoards           = board.getBitBoards();
-    const std::array<__uint128_t, 16>&  enPassantData       = board.getEnPassantData();
+    const SquareIndex                   enPassantSquare     = board.getEnPassantSquare();
+    const uint64_t                      occupied            = bitBoards[PieceType::WHITE_PIECES] | bitBoards[PieceType::BLACK_PIECES];
+    const short                         indexOffset         = whiteTurn ? 0 : PieceType::BLACK-PieceType::WHITE;
+
+    //look up the attacks from the targeted square, any piece of the same type on them is targeting the square
+    if (tables.knight[i] & bitBoards[PieceType::WHITE_KNIGHT + indexOffset]) return true;
+    if (tables.king[i] & bitBoards[PieceType::WHITE_KING + indexOffset]) return true;
+    if (tables.pawnAttacks[whiteTurn ? PieceType::BLACK : PieceType::WHITE][i] & bitBoards[PieceType::WHITE_PAWN + indexOffset]) return true;
+
+    //sliding pieces
+    const uint64_t queens = bitBoards[PieceType::WHITE_QUEEN + indexOffset];
+    if (rookAttacks(i, occupied) & (bitBoards[PieceType::WHITE_ROOK + indexOffset] | queens)) return true;
+    if (bishopAttacks(i, occupied) & (bitBoards[PieceType::WHITE_BISHOP + indexOffset] | queens)) return true;
+
+    //en passant
+    uint64_t enPassantMoves = generateEnPassantBitboard(whiteTurn, bitBoards[PieceType::WHITE_PAWN + indexOffset], enPassantSquare);
+    if (targetedPiece & enPassantMoves) return true;
+
+    return false;
+}
+
+/**
+ * Returns every piece of a given colour targeting a specific square, assuming the given occupancy
+ * 
+ * @param board the board
+ * @param whiteTurn whether or not to find white pieces
+ * @param i the given square index
+ * @param occupied the occupied squares blocking sliding pieces
+ * @return a bitboard of the pieces targeting the square
+ */
+uint64_t generateAttackersBitboard(const Board& board, WhiteTurn whiteTurn, SquareIndex i, uint64_t occupied) {
+    const std::array<uint64_t, 14>&     bitBoards           = board.getBitBoards();
+    const short                         indexOffset         = whiteTurn ? 0 : PieceType::BLACK-PieceType::WHITE;
+    const uint64_t                      queens              = bitBoards[PieceType::WHITE_QUEEN + indexOffset];
+
+    const int                           defenderColour      = whiteTurn ? PieceType::BLACK : PieceType::WHITE;
+
+    return  (tables.knight[i]                           & bitBoards[PieceType::WHITE_KNIGHT + indexOffset])           |
+            (tables.king[i]                             & bitBoards[PieceType::WHITE_KING + indexOffset])             |
+            (tables.pawnAttacks[defenderColour][i]      & bitBoards[PieceType::WHITE_PAWN + indexOffset])             |
+            (rookAttacks(i, occupied)                   & (bitBoards[PieceType::WHITE_ROOK + indexOffset] | queens))   |
+            (bishopAttacks(i, occupied)                 & (bitBoards[PieceType::WHITE_BISHOP + indexOffset] | queens)) ;
+}
+
+/**
+ * Returns every square targeted by a given colour, assuming the given occupancy
+ * 
+ * @param board the board
+ * @param whiteTurn whether or not to find the squares targeted by white
+ * @param occupied the occupied squares blocking sliding pieces
+ * @return a bitboard of the targeted squares
+ */
+uint64_t generateTargetedBitboard(const Board& board, WhiteTurn whiteTurn, uint64_t occupied) {
+    const std::array<uint64_t, 14>&     bitBoards           = board.getBitBoards();
+    const short                         indexOffset         = whiteTurn ? 0 : PieceType::BLACK-PieceType::WHITE;
+    const uint64_t                      queens              = bitBoards[PieceType::WHITE_QUEEN + indexOffset];
+    const uint64_t                      king                = bitBoards[PieceType::WHITE_KING + indexOffset];
+
+    return  (generateKingBitboard(king, king))                                                              |
+            generateKnightBitboard(bitBoards[PieceType::WHITE_KNIGHT + indexOffset], 0)                     |
+            generatePawnTargetBitboard(whiteTurn, bitBoards[PieceType::WHITE_PAWN + indexOffset])           |
+            generateRookBitboard(bitBoards[PieceType::WHITE_ROOK + indexOffset] | queens, occupied, 0)      |
+            generateBishopBitboard(bitBoards[PieceType::WHITE_BISHOP + indexOffset] | queens, occupied, 0)  ;
+}
+
+/**
+ * Calculates the checking pieces, check mask, pin rays, and targeted squares used to generate only legal moves
+ * 
+ * @param board the board
+ * @param whiteTurn whether or not it is whites turn to move
+ * @param kingIndex the square of the king of the side to move
+ * @return the legality masks for the side to move
+ */
+LegalityMasks generateLegalityMasks(const Board& board, WhiteTurn whiteTurn, SquareIndex kingIndex) {
+    const std::array<uint64_t, 14>&     bitBoards           = board.getBitBoards();
     const uint64_t                      whitePieces         = bitBoards[PieceType::WHITE_PIECES];
     const uint64_t                      blackPieces         = bitBoards[PieceType::BLACK_PIECES];
     const uint64_t                      friendlyPieces      = whiteTurn ? whitePieces : blackPieces;
     const uint64_t                      oppositionPieces    = whiteTurn ? blackPieces : whitePieces;
     const uint64_t                      occupied            = whitePieces | blackPieces;
-    const short                         indexOffset         = whiteTurn ? 0 : PieceType::BLACK-PieceType::WHITE;
+    const short                         oppositionOffset    = whiteTurn ? PieceType::BLACK-PieceType::WHITE : 0;
+    const uint64_t                      queens              = bitBoards[PieceType::WHITE_QUEEN + oppositionOffset];
 
-    //generate bitboards for the king and knights
-    uint64_t kingMoves      = generateKingBitboard(bitBoards[PieceType::WHITE_KING + indexOffset], friendlyPieces);
-    uint64_t knightMoves    = generateKnightBitboard(bitBoards[PieceType::WHITE_KNIGHT + indexOffset], friendlyPieces);
-    if (targetedPiece & kingMoves || targetedPiece & knightMoves) return true;
+    LegalityMasks masks{};
 
-    //generate bitboards for sliding pieces
-    uint64_t rookMoves      = generateRookBitboard(bitBoards[PieceType::WHITE_ROOK + indexOffset], occupied, friendlyPieces);
-    uint64_t bishopMoves    = generateBishopBitboard(bitBoards[PieceType::WHITE_BISHOP + indexOffset], occupied, friendlyPieces);
-    uint64_t queenMoves     = generateQueenBitboard(bitBoards[PieceType::WHITE_QUEEN + indexOffset], occupied, friendlyPieces);
-    if (targetedPiece & rookMoves || targetedPiece & bishopMoves || targetedPiece & queenMoves) return true;
+    //the king can't move along the ray of a slider checking it, so it is removed when finding targeted squares
+    masks.targeted = generateTargetedBitboard(board, !whiteTurn, occupied & ~(1ULL << kingIndex));
+    masks.checkers = generateAttackersBitboard(board, !whiteTurn, kingIndex, occupied);
 
-    //generate bitboards for pawns
-    uint64_t pawnAttacks    = generatePawnTargetBitboard(whiteTurn, bitBoards[PieceType::WHITE_PAWN + indexOffset]);
-    uint64_t enPassantMoves = generateEnPassantBitboard(whiteTurn, bitBoards[PieceType::WHITE_PAWN + indexOffset], enPassantData);
-    if (targetedPiece & pawnAttacks || targetedPiece & enPassantMoves) return true;
+    if (!masks.checkers)
+        masks.checkMask = ~0ULL;
+    else if (!(masks.checkers & (masks.checkers-1)))
+        masks.checkMask = masks.checkers | tables.between[kingIndex][__builtin_ctzll(masks.checkers)];
 
-    return false;
+    //sliders that would see the king if only opposition pieces were on the board pin a piece if there is exactly one friendly piece between them
+    uint64_t orthogonalPinners = rookAttacks(kingIndex, oppositionPieces) & (bitBoards[PieceType::WHITE_ROOK + oppositionOffset] | queens);
+    uint64_t diagonalPinners = bishopAttacks(kingIndex, oppositionPieces) & (bitBoards[PieceType::WHITE_BISHOP + oppositionOffset] | queens);
+
+    while (orthogonalPinners) {
+        SquareIndex pinner = (SquareIndex)__builtin_ctzll(orthogonalPinners);
+        uint64_t ray = tables.between[kingIndex][pinner];
+        uint64_t blockers = ray & friendlyPieces;
+
+        if (blockers && !(blockers & (blockers-1)))
+            masks.orthogonalPins |= ray | (1ULL << pinner);
+
+        orthogonalPinners &= orthogonalPinners-1;
+    }
+    while (diagonalPinners) {
+        SquareIndex pinner = (SquareIndex)__builtin_ctzll(diagonalPinners);
+        uint64_t ray = tables.between[kingIndex][pinner];
+        uint64_t blockers = ray & friendlyPieces;
+
+        if (blockers && !(blockers & (blockers-1)))
+            masks.diagonalPins |= ray | (1ULL << pinner);
+
+        diagonalPinners &= diagonalPinners-1;
+    }
+
+    return masks;
 }
@@ -0,0 +1,137 @@
+#include "util/ThreadPool.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// * ----------------------------------------- [ STATIC MEMBERS ] ---------------------------------------- * //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//the pool and queue index of the current thread, null and -1 outside of a pool
+static thread_local ThreadPool* currentPool = nullptr;
+static thread_local int currentWorker = -1;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// * ------------------------------------ [ CONSTRUCTORS/DESCTUCTOR ] ------------------------------------ * //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ThreadPool::ThreadPool(int threadCount) {
+    start(threadCount);
+}
+
+ThreadPool::~ThreadPool() {
+    stop();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// * ----------------------------------------- [ PUBLIC METHODS ] ---------------------------------------- * //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Restarts the pool with the given number of workers, finishing any queued jobs first. Must not be called
+ * from inside the pool
+ *
+ * @param threadCount the number of workers, at least 1
+ */
+void ThreadPool::resize(int threadCount) {
+    stop();
+    start(threadCount);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// * ----------------------------------------- [ HELPER METHODS ] ---------------------------------------- * //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPool::start(int threadCount) {
+    threadCount = std::max(threadCount, 1);
+
+    for (int i = 0; i < threadCount; i++)
+        queues.push_back(std::make_unique<WorkerQueue>());
+    for (int i = 0; i < threadCount; i++)
+        threads.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+//lets the workers drain their queues then joins them
+void ThreadPool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    threads.clear();
+    queues.clear();
+    stopping = false;
+}
+
+void ThreadPool::push(Job job) {
+    int index = currentPool == this ? currentWorker : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->jobs.push_back(std::move(job));
+    }
+    queuedJobs.fetch_add(1);
+
+    //taking the sleep mutex stops the notify landing between a worker checking queuedJobs and going to sleep
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    wakeUp.notify_one();
+}
+
+/**
+ * Takes and runs one queued job, the newest of the current worker's own queue if it has any, otherwise the oldest
+ * of the first other queue that has one
+ *
+ * @return whether or not a job was run
+ */
+bool ThreadPool::runQueuedJob() {
+    const int self = currentPool == this ? currentWorker : -1;
+    const int count = queues.size();
+    Job job;
+
+    if (self >= 0) {
+        std::lock_guard<std::mutex> lock(queues[self]->mutex);
+        if (!queues[self]->jobs.empty()) {
+            job = std::move(queues[self]->jobs.back());
+            queues[self]->jobs.pop_back();
+        }
+    }
+
+    for (int i = 1; !job && i <= count; i++) {
+        WorkerQueue& victim = *queues[(self + i + count) % count];
+
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+        }
+    }
+
+    if (!job)
+        return false;
+
+    queuedJobs.fetch_sub(1);
+    job();
+    return true;
+}
+
+void ThreadPool::workerLoop(int index) {
+    currentPool = this;
+    currentWorker = index;
+
+    for (;;) {
+        if (runQueuedJob())
+            continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this](){ return stopping || queuedJobs.load() > 0; });
+
+        if (stopping && queuedJobs.load() == 0)
+            return;
+    }
+}